@@ -0,0 +1,382 @@
+/**
+ * backend_selector.cpp
+ * Implementasi model biaya per backend, kalibrasi, profil persisten, dan mode --calibrate-backends.
+ */
+#include "backend_selector.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <omp.h>
+#include <unistd.h>
+
+static const Backend ALL_BACKENDS[BACKEND_COUNT] = {Backend::Serial, Backend::OpenMP, Backend::OpenCL};
+static const double ONLINE_DECAY = 0.98; // bobot sampel lama per frame baru (~50 frame efektif)
+static const int PROFILE_FORMAT = 2;     // v1 menyimpan kolom weight yang tidak terpakai
+
+static std::string host_name() {
+    char buf[256] = {};
+    if (gethostname(buf, sizeof(buf) - 1) != 0) return "unknown";
+    return buf;
+}
+
+// =======================================================================================
+// PERKIRAAN BIAYA FRAME
+// =======================================================================================
+
+CostEstimate estimate_frame_cost(const RenderRequest& r, int probe_width) {
+    CostEstimate est;
+    const int pw = std::max(2, std::min(probe_width, r.width));
+    const int ph = std::max(2, std::min(r.height, static_cast<int>(std::lround(static_cast<double>(pw) * r.height / r.width))));
+    std::vector<int32_t> probe(static_cast<size_t>(pw) * ph);
+
+    auto start = std::chrono::steady_clock::now();
+    generate_iterations_region(probe.data(), pw, pw, ph, 0, 0, pw, ph, r.min_re, r.max_re, r.min_im, r.max_im,
+                               r.is_julia, r.julia_c, r.max_iterations);
+    est.probe_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    double sum = 0.0;
+    for (int32_t it : probe) sum += it;
+    est.mean_iterations = sum / probe.size();
+    est.megapixels = static_cast<double>(r.width) * r.height / 1e6;
+    est.giga_iterations = est.megapixels * est.mean_iterations / 1e3;
+    return est;
+}
+
+// =======================================================================================
+// MODEL LINEAR PER BACKEND
+// =======================================================================================
+
+void BackendCostModel::add_sample(const CostEstimate& e, double elapsed_ms, double decay) {
+    const double x[FEATURES] = {1.0, e.megapixels, e.giga_iterations};
+    // Bobot 1/t^2: yang diminimalkan adalah kesalahan relatif, sehingga thumbnail (di mana
+    // overhead dominan) sama pentingnya dengan frame besar.
+    const double w = 1.0 / std::pow(std::max(elapsed_ms, 0.05), 2.0);
+    for (int i = 0; i < FEATURES; ++i) {
+        for (int j = 0; j < FEATURES; ++j) xtx[i][j] = xtx[i][j] * decay + w * x[i] * x[j];
+        xty[i] = xty[i] * decay + w * x[i] * elapsed_ms;
+    }
+    samples++;
+}
+
+// Least squares dengan sedikit ridge; koefisien negatif (tidak fisik) dinolkan lalu sisanya
+// di-fit ulang (active set sederhana, paling banyak FEATURES putaran).
+void BackendCostModel::solve() {
+    bool active[FEATURES] = {true, true, true};
+    for (int round = 0; round < FEATURES; ++round) {
+        double a[FEATURES][FEATURES + 1] = {};
+        for (int i = 0; i < FEATURES; ++i) {
+            for (int j = 0; j < FEATURES; ++j) a[i][j] = (active[i] && active[j]) ? xtx[i][j] : 0.0;
+            a[i][i] = active[i] ? a[i][i] * (1.0 + 1e-9) + 1e-12 : 1.0;
+            a[i][FEATURES] = active[i] ? xty[i] : 0.0;
+        }
+        for (int col = 0; col < FEATURES; ++col) {
+            int pivot = col;
+            for (int row = col + 1; row < FEATURES; ++row)
+                if (std::abs(a[row][col]) > std::abs(a[pivot][col])) pivot = row;
+            for (int k = 0; k <= FEATURES; ++k) std::swap(a[col][k], a[pivot][k]);
+            if (a[col][col] == 0.0) continue;
+            for (int row = 0; row < FEATURES; ++row) {
+                if (row == col) continue;
+                double f = a[row][col] / a[col][col];
+                for (int k = col; k <= FEATURES; ++k) a[row][k] -= f * a[col][k];
+            }
+        }
+        bool negative = false;
+        for (int i = 0; i < FEATURES; ++i) {
+            coef[i] = (active[i] && a[i][i] != 0.0) ? a[i][FEATURES] / a[i][i] : 0.0;
+            if (coef[i] < 0.0) { active[i] = false; negative = true; }
+        }
+        if (!negative) return;
+    }
+    for (double& c : coef) c = std::max(0.0, c);
+}
+
+double BackendCostModel::predict(const CostEstimate& e) const {
+    return coef[0] + coef[1] * e.megapixels + coef[2] * e.giga_iterations;
+}
+
+// =======================================================================================
+// SELECTOR
+// =======================================================================================
+
+BackendSelector::BackendSelector(std::string path) : profile_path(std::move(path)) {
+    for (int i = 0; i < BACKEND_COUNT; ++i) usable[i] = true;
+    #ifndef ENABLE_OPENCL
+    usable[static_cast<int>(Backend::OpenCL)] = false;
+    #endif
+}
+
+bool BackendSelector::load() {
+    std::ifstream in(profile_path);
+    if (!in) return false;
+    std::string line, host;
+    int threads = 0, format = 0;
+    BackendCostModel loaded[BACKEND_COUNT];
+    bool missing[BACKEND_COUNT] = {};
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream ls(line);
+        std::string tag;
+        ls >> tag;
+        if (tag == "format") {
+            ls >> format;
+        } else if (tag == "host") {
+            ls >> host >> tag >> threads;
+        } else if (tag == "model") {
+            std::string name;
+            Backend kind;
+            BackendCostModel m;
+            ls >> name >> m.samples;
+            for (auto& row : m.xtx) for (double& v : row) ls >> v;
+            for (double& v : m.xty) ls >> v;
+            if (!ls || !parse_backend(name, kind)) continue;
+            m.solve();
+            loaded[static_cast<int>(kind)] = m;
+        } else if (tag == "unavailable") {
+            std::string name;
+            Backend kind;
+            if (ls >> name && parse_backend(name, kind)) missing[static_cast<int>(kind)] = true;
+        }
+    }
+    if (format != PROFILE_FORMAT) {
+        std::cerr << "Profil backend " << profile_path << " memakai format lama, diabaikan\n";
+        return false;
+    }
+    // Throughput OpenMP (dan overhead OpenCL) bergantung pada mesin dan jumlah thread
+    if (host != host_name() || threads != omp_get_max_threads()) {
+        std::cerr << "Profil backend " << profile_path << " dibuat untuk " << host << "/" << threads
+                  << " thread, diabaikan\n";
+        return false;
+    }
+    for (int i = 0; i < BACKEND_COUNT; ++i) {
+        models[i] = loaded[i];
+        if (missing[i]) usable[i] = false;
+    }
+    return true;
+}
+
+bool BackendSelector::save() const {
+    std::ofstream out(profile_path);
+    if (!out) return false;
+    out << "# fractal_generator backend profile\n"
+        << "# model <backend> <samples> <X^T W X (3x3)> <X^T W y (3)>, X = [1, Mpiksel, Giterasi], y = ms, W = 1/y^2\n"
+        << "format " << PROFILE_FORMAT << "\n"
+        << "host " << host_name() << " threads " << omp_get_max_threads() << "\n";
+    out << std::setprecision(17);
+    for (int i = 0; i < BACKEND_COUNT; ++i) {
+        const BackendCostModel& m = models[i];
+        // Backend yang gagal saat kalibrasi dicatat agar run berikutnya tidak mengkalibrasi ulang
+        if (!usable[i]) { out << "unavailable " << backend_name(ALL_BACKENDS[i]) << "\n"; continue; }
+        if (m.samples == 0) continue;
+        out << "# " << backend_name(ALL_BACKENDS[i]) << ": overhead " << m.coef[0] << " ms, " << m.coef[1]
+            << " ms/Mpiksel, " << m.coef[2] << " ms/Giterasi\n";
+        out << "model " << backend_name(ALL_BACKENDS[i]) << " " << m.samples;
+        for (const auto& row : m.xtx) for (double v : row) out << " " << v;
+        for (double v : m.xty) out << " " << v;
+        out << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+void BackendSelector::calibrate(Renderer& renderer, bool verbose) {
+    struct Case { int w, h, max_it; bool julia; };
+    // Variasi ukuran dan batas iterasi agar overhead, biaya per piksel, dan biaya per iterasi terpisah
+    const Case cases[] = {
+        {96, 54, MAX_ITERATIONS, false}, {320, 180, 100, false}, {320, 180, MAX_ITERATIONS, false},
+        {640, 360, MAX_ITERATIONS, true}, {960, 540, 250, false},
+    };
+    if (verbose) std::cout << "Kalibrasi backend (" << omp_get_max_threads() << " thread OpenMP)...\n";
+
+    for (int b = 0; b < BACKEND_COUNT; ++b) {
+        if (!usable[b]) continue;
+        RenderRequest warm;
+        warm.width = 96; warm.height = 54; warm.backend = ALL_BACKENDS[b];
+        std::vector<uint8_t> buf(static_cast<size_t>(warm.width) * warm.height * 3);
+        RenderResult wr = renderer.render(warm, buf.data(), static_cast<size_t>(warm.width) * 3); // init konteks/pool thread
+        if (!wr.ok) {
+            if (verbose) std::cout << "  " << std::left << std::setw(8) << backend_name(ALL_BACKENDS[b]) << std::right
+                                   << "tidak tersedia: " << wr.error << "\n";
+            usable[b] = false;
+            continue;
+        }
+        BackendCostModel model;
+        for (const Case& c : cases) {
+            RenderRequest r;
+            r.width = c.w; r.height = c.h; r.max_iterations = c.max_it; r.backend = ALL_BACKENDS[b];
+            r.max_im = r.min_im + (r.max_re - r.min_re) * static_cast<float>(c.h) / c.w;
+            if (c.julia) {
+                r.is_julia = true; r.julia_c = {-0.8f, 0.156f};
+                r.min_re = -1.6f; r.max_re = 1.6f; r.min_im = -0.9f; r.max_im = 0.9f;
+            }
+            CostEstimate est = estimate_frame_cost(r);
+            buf.resize(static_cast<size_t>(c.w) * c.h * 3);
+            double times[3];
+            for (double& t : times) t = renderer.render(r, buf.data(), static_cast<size_t>(c.w) * 3).elapsed_ms;
+            std::sort(times, times + 3);
+            model.add_sample(est, times[1], 1.0);
+        }
+        model.solve();
+        models[b] = model;
+        if (verbose) {
+            std::cout << std::fixed << std::setprecision(3) << "  " << std::left << std::setw(8)
+                      << backend_name(ALL_BACKENDS[b]) << std::right << "overhead " << model.coef[0] << " ms, "
+                      << model.coef[1] << " ms/Mpiksel, " << std::setprecision(1)
+                      << (model.coef[2] > 0 ? 1e6 / model.coef[2] : 0.0) << " Miter/s\n";
+        }
+    }
+}
+
+bool BackendSelector::calibrated() const {
+    bool any = false;
+    for (int i = 0; i < BACKEND_COUNT; ++i) {
+        if (!usable[i]) continue;
+        if (models[i].samples < BackendCostModel::FEATURES) return false;
+        any = true;
+    }
+    return any;
+}
+
+void BackendSelector::load_or_calibrate(Renderer& renderer) {
+    if (load() && calibrated()) {
+        std::cout << "Profil backend dimuat dari " << profile_path << "\n";
+        return;
+    }
+    calibrate(renderer);
+    if (!save()) std::cerr << "Error: Gagal menulis profil backend " << profile_path << "\n";
+}
+
+BackendChoice BackendSelector::choose(const RenderRequest& request) const {
+    BackendChoice choice;
+    choice.estimate = estimate_frame_cost(request);
+    double best = 0.0;
+    bool found = false;
+    for (int i = 0; i < BACKEND_COUNT; ++i) {
+        if (!usable[i] || models[i].samples < BackendCostModel::FEATURES) continue;
+        choice.candidate[i] = true;
+        choice.predicted_ms[i] = models[i].predict(choice.estimate);
+        if (!found || choice.predicted_ms[i] < best) {
+            best = choice.predicted_ms[i];
+            choice.backend = ALL_BACKENDS[i];
+            found = true;
+        }
+    }
+    return choice;
+}
+
+void BackendSelector::record(const BackendChoice& choice, const RenderResult& result) {
+    if (!result.ok) return;
+    BackendCostModel& m = models[static_cast<int>(result.backend)];
+    m.add_sample(choice.estimate, result.elapsed_ms, ONLINE_DECAY);
+    m.solve();
+}
+
+void BackendSelector::mark_unavailable(Backend backend) {
+    usable[static_cast<int>(backend)] = false;
+}
+
+std::string BackendSelector::describe(const BackendChoice& choice, const RenderResult& result) const {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << "auto -> " << backend_name(result.backend);
+    if (result.backend != choice.backend) ss << " (fallback dari " << backend_name(choice.backend) << ")";
+    ss << " | prediksi " << choice.predicted_ms[static_cast<int>(choice.backend)] << " ms (";
+    bool first = true;
+    for (int i = 0; i < BACKEND_COUNT; ++i) {
+        if (!choice.candidate[i]) continue;
+        ss << (first ? "" : ", ") << backend_name(ALL_BACKENDS[i]) << " " << choice.predicted_ms[i];
+        first = false;
+    }
+    ss << ") | aktual " << result.elapsed_ms << " ms | probe " << std::setprecision(2) << choice.estimate.probe_ms
+       << " ms, ~" << std::setprecision(0) << choice.estimate.mean_iterations << " iter/piksel";
+    return ss.str();
+}
+
+void BackendSelector::print_profile(std::ostream& out) const {
+    out << std::left << std::setw(10) << "Backend" << std::right << std::setw(9) << "Sampel" << std::setw(15)
+        << "Overhead(ms)" << std::setw(15) << "ms/Mpiksel" << std::setw(13) << "Miter/s" << "\n";
+    for (int i = 0; i < BACKEND_COUNT; ++i) {
+        const BackendCostModel& m = models[i];
+        out << std::left << std::setw(10) << backend_name(ALL_BACKENDS[i]) << std::right;
+        if (!usable[i] || m.samples == 0) { out << std::setw(9) << "-" << "  (tidak tersedia / belum dikalibrasi)\n"; continue; }
+        out << std::setw(9) << m.samples << std::fixed << std::setprecision(3) << std::setw(15) << m.coef[0]
+            << std::setw(15) << m.coef[1] << std::setprecision(1) << std::setw(13)
+            << (m.coef[2] > 0 ? 1e6 / m.coef[2] : 0.0) << "\n";
+    }
+}
+
+// =======================================================================================
+// MODE --calibrate-backends
+// =======================================================================================
+
+void run_backend_calibration(const std::string& profile_path) {
+    BackendSelector selector(profile_path);
+    Renderer renderer;
+    selector.calibrate(renderer);
+    if (selector.save()) std::cout << "Profil disimpan ke " << profile_path << "\n\n";
+    else std::cerr << "Error: Gagal menulis " << profile_path << "\n";
+    selector.print_profile(std::cout);
+
+    // Validasi: setiap backend dirender (kecuali yang diprediksi terlalu lama) dan dibandingkan
+    // dengan pilihan selector.
+    struct Case { int w, h; float min_re, max_re, min_im; };
+    const Case cases[] = {
+        {64, 36, -2.0f, 1.0f, -1.2f}, {160, 90, -2.0f, 1.0f, -1.2f}, {480, 270, -2.0f, 1.0f, -1.2f},
+        {1280, 720, -0.75f, -0.73f, 0.1f}, {1920, 1080, -2.0f, 1.0f, -1.2f},
+    };
+    const double skip_ms = 3000.0;
+    std::cout << "\n" << std::left << std::setw(12) << "Frame" << std::setw(10) << "Pilihan" << std::right;
+    for (Backend b : ALL_BACKENDS) std::cout << std::setw(20) << (std::string(backend_name(b)) + " pred/akt");
+    std::cout << "  Tercepat\n";
+
+    int optimal = 0, total = 0;
+    double rel_error_sum = 0.0;
+    int rel_error_count = 0;
+    for (const Case& c : cases) {
+        RenderRequest r;
+        r.width = c.w; r.height = c.h; r.min_re = c.min_re; r.max_re = c.max_re; r.min_im = c.min_im;
+        r.max_im = c.min_im + (c.max_re - c.min_re) * static_cast<float>(c.h) / c.w;
+        BackendChoice choice = selector.choose(r);
+        std::vector<uint8_t> buf(static_cast<size_t>(c.w) * c.h * 3);
+
+        std::ostringstream label;
+        label << c.w << "x" << c.h;
+        std::cout << std::left << std::setw(12) << label.str() << std::setw(10) << backend_name(choice.backend) << std::right;
+        int fastest = -1;
+        double fastest_ms = 0.0;
+        for (int i = 0; i < BACKEND_COUNT; ++i) {
+            std::ostringstream cell;
+            cell << std::fixed << std::setprecision(1);
+            if (!choice.candidate[i]) {
+                cell << "-";
+            } else if (choice.predicted_ms[i] > skip_ms) {
+                cell << choice.predicted_ms[i] << "/-";
+            } else {
+                r.backend = ALL_BACKENDS[i];
+                RenderResult res = selector.available(r.backend) ? renderer.render(r, buf.data(), static_cast<size_t>(c.w) * 3)
+                                                                 : RenderResult();
+                if (!res.ok) { cell << choice.predicted_ms[i] << "/gagal"; }
+                else {
+                    cell << choice.predicted_ms[i] << "/" << res.elapsed_ms;
+                    rel_error_sum += std::abs(choice.predicted_ms[i] - res.elapsed_ms) / std::max(res.elapsed_ms, 0.05);
+                    rel_error_count++;
+                    if (fastest < 0 || res.elapsed_ms < fastest_ms) { fastest = i; fastest_ms = res.elapsed_ms; }
+                }
+            }
+            std::cout << std::setw(20) << cell.str();
+        }
+        std::cout << "  " << (fastest >= 0 ? backend_name(ALL_BACKENDS[fastest]) : "-") << "\n";
+        if (fastest >= 0) {
+            total++;
+            if (ALL_BACKENDS[fastest] == choice.backend) optimal++;
+        }
+    }
+    std::cout << std::fixed << std::setprecision(1) << "\nPilihan optimal: " << optimal << "/" << total
+              << ", rata-rata kesalahan prediksi: "
+              << (rel_error_count ? 100.0 * rel_error_sum / rel_error_count : 0.0) << "%\n";
+}
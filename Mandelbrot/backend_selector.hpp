@@ -0,0 +1,88 @@
+/**
+ * backend_selector.hpp
+ * Pemilihan backend otomatis (serial / OpenMP / OpenCL) berdasarkan model biaya.
+ *
+ * Biaya frame diperkirakan dari resolusi, batas iterasi, dan probe resolusi rendah (32 px lebar,
+ * serial) yang memberi rata-rata iterasi per piksel untuk view tersebut. Untuk setiap backend
+ * disimpan model linear
+ *     t_ms = overhead_ms + ms_per_mpixel * Mpiksel + ms_per_giter * Giterasi
+ * yang di-fit dengan weighted least squares dari kalibrasi awal dan dari setiap frame yang
+ * benar-benar dirender. Setiap sampel berbobot 1/t^2 (yang diminimalkan adalah kesalahan relatif)
+ * dan statistik cukup X^T W X / X^T W y meluruh dengan faktor decay per sampel baru. Profil disimpan ke file teks
+ * sehingga run berikutnya langsung memakai throughput dan overhead yang sudah terukur.
+ */
+#pragma once
+
+#include <iosfwd>
+#include <string>
+
+#include "fractal_renderer.hpp"
+
+const char* const DEFAULT_BACKEND_PROFILE = "fractal_backend_profile.txt";
+const int BACKEND_COUNT = 3; // indeks = static_cast<int>(Backend)
+
+// Perkiraan kerja satu frame dari probe resolusi rendah
+struct CostEstimate {
+    double megapixels = 0.0;
+    double giga_iterations = 0.0;   // perkiraan total iterasi frame / 1e9
+    double mean_iterations = 0.0;   // rata-rata iterasi per piksel pada probe
+    double probe_ms = 0.0;
+};
+
+CostEstimate estimate_frame_cost(const RenderRequest& request, int probe_width = 32);
+
+struct BackendCostModel {
+    static const int FEATURES = 3;  // [1, Mpiksel, Giterasi]
+    double xtx[FEATURES][FEATURES] = {}; // X^T W X
+    double xty[FEATURES] = {};           // X^T W y
+    long long samples = 0;
+    double coef[FEATURES] = {};     // overhead_ms, ms_per_mpixel, ms_per_giter
+
+    void add_sample(const CostEstimate& estimate, double elapsed_ms, double decay);
+    void solve();
+    double predict(const CostEstimate& estimate) const;
+};
+
+struct BackendChoice {
+    Backend backend = Backend::OpenMP;
+    CostEstimate estimate;
+    double predicted_ms[BACKEND_COUNT] = {};
+    bool candidate[BACKEND_COUNT] = {};
+};
+
+class BackendSelector {
+public:
+    explicit BackendSelector(std::string profile_path = DEFAULT_BACKEND_PROFILE);
+
+    // Profil hanya dipakai jika host dan jumlah thread OpenMP sama dengan saat dibuat.
+    bool load();
+    bool save() const;
+
+    // Render set frame kalibrasi dengan setiap backend yang tersedia (backend yang gagal
+    // ditandai tidak tersedia untuk sesi ini). Menimpa sampel lama.
+    void calibrate(Renderer& renderer, bool verbose = true);
+    bool calibrated() const;
+    // Profil dari file jika cocok dan lengkap; jika tidak, kalibrasi lalu simpan.
+    void load_or_calibrate(Renderer& renderer);
+
+    BackendChoice choose(const RenderRequest& request) const;
+    // Tambahkan hasil render nyata ke model backend yang benar-benar dipakai (result.backend).
+    void record(const BackendChoice& choice, const RenderResult& result);
+    void mark_unavailable(Backend backend);
+    bool available(Backend backend) const { return usable[static_cast<int>(backend)]; }
+
+    // "auto -> opencl | prediksi 12.3 ms (serial 80.1, openmp 20.4, opencl 12.3) | aktual 13.0 ms"
+    std::string describe(const BackendChoice& choice, const RenderResult& result) const;
+    void print_profile(std::ostream& out) const;
+
+    const std::string& path() const { return profile_path; }
+
+private:
+    std::string profile_path;
+    BackendCostModel models[BACKEND_COUNT];
+    bool usable[BACKEND_COUNT];
+};
+
+// Mode --calibrate-backends: kalibrasi ulang, simpan profil, lalu bandingkan prediksi dengan
+// waktu aktual untuk frame thumbnail sampai frame besar.
+void run_backend_calibration(const std::string& profile_path);
@@ -0,0 +1,279 @@
+/**
+ * checkpoint_render.cpp
+ * Implementasi render dengan checkpoint (file scratch mmap + bitmap tile) dan inspeksi progress.
+ */
+#include "checkpoint_render.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <fcntl.h>
+#include <omp.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "stb_image_write.h"
+
+static std::atomic<bool> g_checkpoint_stop{false};
+
+static void checkpoint_signal_handler(int) {
+    g_checkpoint_stop = true;
+}
+
+static uint64_t round_up_page(uint64_t bytes) {
+    uint64_t page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    return (bytes + page - 1) / page * page;
+}
+
+// Semua ukuran turunan (grid tile, bitmap, plane data) dihitung ulang dari width/height/tile_size
+// dan dicocokkan dengan header serta ukuran file, sehingga header rusak tidak bisa membuat mmap
+// atau indeks tile keluar dari file. Batas dimensi menjaga perkalian 64-bit dari overflow.
+static bool header_valid(const CheckpointHeader& h, uint64_t file_size) {
+    const int32_t max_dim = 1 << 24;
+    if (std::memcmp(h.magic, CHECKPOINT_MAGIC, sizeof(h.magic)) != 0 || h.version != CHECKPOINT_VERSION ||
+        h.header_bytes != CHECKPOINT_HEADER_BYTES || h.width < 2 || h.height < 2 || h.width > max_dim ||
+        h.height > max_dim || h.tile_size < 1 || h.max_iterations < 1)
+        return false;
+    const int32_t tiles_x = (h.width + h.tile_size - 1) / h.tile_size;
+    const int32_t tiles_y = (h.height + h.tile_size - 1) / h.tile_size;
+    const uint64_t tiles = static_cast<uint64_t>(tiles_x) * tiles_y;
+    const uint64_t bitmap_bytes = (tiles + 7) / 8;
+    const uint64_t data_bytes = static_cast<uint64_t>(h.width) * h.height * sizeof(int32_t);
+    return h.tiles_x == tiles_x && h.tiles_y == tiles_y && h.bitmap_bytes == bitmap_bytes &&
+           h.data_bytes == data_bytes && h.bitmap_offset == CHECKPOINT_HEADER_BYTES &&
+           h.file_bytes == file_size && h.data_offset <= file_size && data_bytes <= file_size - h.data_offset &&
+           h.data_offset >= h.bitmap_offset && bitmap_bytes <= h.data_offset - h.bitmap_offset &&
+           h.data_offset % sizeof(int32_t) == 0;
+}
+
+static bool tile_bit(const uint8_t* bitmap, int tile) { return (bitmap[tile >> 3] >> (tile & 7)) & 1; }
+static void set_tile_bit(uint8_t* bitmap, int tile) { bitmap[tile >> 3] |= static_cast<uint8_t>(1u << (tile & 7)); }
+
+// =======================================================================================
+// RENDER DENGAN CHECKPOINT
+// =======================================================================================
+
+void run_checkpoint_render(const CheckpointConfig& cfg) {
+    int fd = open(cfg.path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) { std::cerr << "Error: Gagal membuka " << cfg.path << "\n"; return; }
+    struct stat st;
+    fstat(fd, &st);
+
+    CheckpointHeader hdr;
+    std::memset(&hdr, 0, sizeof(hdr));
+    bool resumed = false;
+    if (st.st_size > 0) {
+        if (pread(fd, &hdr, sizeof(hdr), 0) != static_cast<ssize_t>(sizeof(hdr)) ||
+            !header_valid(hdr, static_cast<uint64_t>(st.st_size))) {
+            std::cerr << "Error: " << cfg.path << " bukan file checkpoint yang valid (hapus file untuk mulai baru)\n";
+            close(fd);
+            return;
+        }
+        resumed = true;
+        if (hdr.finished) {
+            std::cout << "Render di " << cfg.path << " sudah selesai.\n";
+        }
+    } else {
+        // File baru: parameter dari konfigurasi
+        std::memcpy(hdr.magic, CHECKPOINT_MAGIC, sizeof(hdr.magic));
+        hdr.version = CHECKPOINT_VERSION;
+        hdr.header_bytes = CHECKPOINT_HEADER_BYTES;
+        hdr.width = cfg.width; hdr.height = cfg.height;
+        hdr.tile_size = std::max(1, cfg.tile_size);
+        hdr.tiles_x = (cfg.width + hdr.tile_size - 1) / hdr.tile_size;
+        hdr.tiles_y = (cfg.height + hdr.tile_size - 1) / hdr.tile_size;
+        hdr.max_iterations = cfg.max_iterations;
+        hdr.is_julia = cfg.is_julia ? 1 : 0;
+        hdr.min_re = cfg.min_re; hdr.max_re = cfg.max_re; hdr.min_im = cfg.min_im;
+        hdr.max_im = cfg.min_im + (cfg.max_re - cfg.min_re) * static_cast<double>(cfg.height) / cfg.width;
+        hdr.julia_re = cfg.julia_c.real(); hdr.julia_im = cfg.julia_c.imag();
+        uint64_t tiles = static_cast<uint64_t>(hdr.tiles_x) * hdr.tiles_y;
+        hdr.bitmap_offset = CHECKPOINT_HEADER_BYTES;
+        hdr.bitmap_bytes = (tiles + 7) / 8;
+        hdr.data_offset = hdr.bitmap_offset + round_up_page(hdr.bitmap_bytes);
+        hdr.data_bytes = static_cast<uint64_t>(hdr.width) * hdr.height * sizeof(int32_t);
+        hdr.file_bytes = hdr.data_offset + round_up_page(hdr.data_bytes);
+        hdr.started_unix = static_cast<int64_t>(std::time(nullptr));
+        // ftruncate membuat file sparse: halaman data baru memakan disk setelah ditulis
+        if (ftruncate(fd, static_cast<off_t>(hdr.file_bytes)) != 0) {
+            std::cerr << "Error: Gagal mengalokasikan " << hdr.file_bytes << " byte untuk " << cfg.path << "\n";
+            close(fd);
+            return;
+        }
+    }
+
+    void* mem = mmap(nullptr, hdr.file_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) { std::cerr << "Error: mmap gagal untuk " << cfg.path << "\n"; return; }
+    uint8_t* base = static_cast<uint8_t*>(mem);
+    CheckpointHeader* live = reinterpret_cast<CheckpointHeader*>(base);
+    if (!resumed) std::memcpy(live, &hdr, sizeof(hdr));
+    uint8_t* file_bitmap = base + hdr.bitmap_offset;
+    int32_t* data = reinterpret_cast<int32_t*>(base + hdr.data_offset);
+
+    const int tiles_total = hdr.tiles_x * hdr.tiles_y;
+    // Salinan bitmap di memori; bit baru dipublikasikan ke file hanya setelah datanya di-msync
+    std::vector<uint8_t> bitmap(file_bitmap, file_bitmap + hdr.bitmap_bytes);
+    std::vector<int> pending;
+    for (int t = 0; t < tiles_total; ++t)
+        if (!tile_bit(bitmap.data(), t)) pending.push_back(t);
+
+    const float min_re = static_cast<float>(hdr.min_re), max_re = static_cast<float>(hdr.max_re);
+    const float min_im = static_cast<float>(hdr.min_im), max_im = static_cast<float>(hdr.max_im);
+    const std::complex<float> julia_c(static_cast<float>(hdr.julia_re), static_cast<float>(hdr.julia_im));
+
+    std::cout << (resumed ? "Melanjutkan " : "Memulai ") << cfg.path << ": " << hdr.width << "x" << hdr.height
+              << ", tile " << hdr.tile_size << " (" << tiles_total << " tile, " << tiles_total - pending.size()
+              << " sudah selesai), iterasi maks " << hdr.max_iterations << ", file "
+              << std::fixed << std::setprecision(1) << hdr.file_bytes / 1048576.0 << " MiB\n";
+
+    live->sessions++;
+    live->running = 1;
+    live->tiles_done = static_cast<uint64_t>(tiles_total - pending.size());
+
+    g_checkpoint_stop = false;
+    auto old_int = std::signal(SIGINT, checkpoint_signal_handler);
+    auto old_term = std::signal(SIGTERM, checkpoint_signal_handler);
+
+    const double prior_active = live->active_seconds;
+    const auto session_start = std::chrono::steady_clock::now();
+    auto session_seconds = [&] {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - session_start).count();
+    };
+    auto checkpoint = [&] {
+        PROFILE_SCOPE("checkpoint_msync");
+        // Urutan: data -> bitmap/header, agar bit tidak pernah mendahului data di disk
+        msync(data, hdr.data_bytes, MS_SYNC);
+        std::memcpy(file_bitmap, bitmap.data(), hdr.bitmap_bytes);
+        uint64_t persisted = 0;
+        for (int t = 0; t < tiles_total; ++t) persisted += tile_bit(bitmap.data(), t);
+        live->tiles_persisted = persisted;
+        live->updated_unix = static_cast<int64_t>(std::time(nullptr));
+        msync(base, hdr.data_offset, MS_SYNC);
+    };
+
+    const int batch = std::max(1, omp_get_max_threads() * 4);
+    auto last_checkpoint = std::chrono::steady_clock::now();
+    size_t next = 0;
+    while (next < pending.size() && !g_checkpoint_stop) {
+        size_t end = std::min(pending.size(), next + batch);
+        #pragma omp parallel for schedule(dynamic)
+        for (long long i = static_cast<long long>(next); i < static_cast<long long>(end); ++i) {
+            int t = pending[i];
+            int x0 = (t % hdr.tiles_x) * hdr.tile_size, y0 = (t / hdr.tiles_x) * hdr.tile_size;
+            int w = std::min(hdr.tile_size, hdr.width - x0), h = std::min(hdr.tile_size, hdr.height - y0);
+            generate_iterations_region(data + static_cast<size_t>(y0) * hdr.width + x0, hdr.width,
+                                       hdr.width, hdr.height, x0, y0, w, h, min_re, max_re, min_im, max_im,
+                                       hdr.is_julia != 0, julia_c, hdr.max_iterations);
+        }
+        for (size_t i = next; i < end; ++i) set_tile_bit(bitmap.data(), pending[i]);
+        next = end;
+
+        live->tiles_done = static_cast<uint64_t>(tiles_total - (pending.size() - next));
+        live->active_seconds = prior_active + session_seconds();
+        live->updated_unix = static_cast<int64_t>(std::time(nullptr));
+
+        auto now = std::chrono::steady_clock::now();
+        if (std::chrono::duration<double>(now - last_checkpoint).count() >= cfg.interval_seconds) {
+            checkpoint();
+            last_checkpoint = now;
+        }
+        std::cout << "\rTile " << live->tiles_done << "/" << tiles_total << std::flush;
+    }
+
+    const bool complete = (next == pending.size());
+    live->running = 0;
+    live->finished = complete ? 1 : 0;
+    live->active_seconds = prior_active + session_seconds();
+    checkpoint();
+    std::signal(SIGINT, old_int);
+    std::signal(SIGTERM, old_term);
+    std::cout << "\n";
+
+    if (!complete) {
+        std::cout << "Dihentikan setelah checkpoint (" << live->tiles_persisted << "/" << tiles_total
+                  << " tile tersimpan). Jalankan perintah yang sama untuk melanjutkan.\n";
+        munmap(base, hdr.file_bytes);
+        return;
+    }
+
+    std::string png = cfg.output_png;
+    if (png.empty()) {
+        size_t dot = cfg.path.find_last_of('.');
+        png = (dot == std::string::npos ? cfg.path : cfg.path.substr(0, dot)) + ".png";
+    }
+    std::vector<uint8_t> pixels(static_cast<size_t>(hdr.width) * hdr.height * 3);
+    #pragma omp parallel for
+    for (long long i = 0; i < static_cast<long long>(hdr.width) * hdr.height; ++i) {
+        Color color = map_iteration_to_color(data[i], hdr.max_iterations);
+        pixels[i * 3] = color.r; pixels[i * 3 + 1] = color.g; pixels[i * 3 + 2] = color.b;
+    }
+    stbi_write_png(png.c_str(), hdr.width, hdr.height, 3, pixels.data(), hdr.width * 3);
+    std::cout << std::fixed << std::setprecision(1) << "Selesai dalam " << live->active_seconds
+              << " s waktu render aktif (" << live->sessions << " sesi). Output: " << png << "\n";
+    munmap(base, hdr.file_bytes);
+}
+
+// =======================================================================================
+// INSPEKSI PROGRESS DARI PROSES LAIN
+// =======================================================================================
+
+void print_checkpoint_status(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) { std::cerr << "Error: Gagal membuka " << path << "\n"; return; }
+    struct stat st;
+    fstat(fd, &st);
+    CheckpointHeader hdr;
+    if (pread(fd, &hdr, sizeof(hdr), 0) != static_cast<ssize_t>(sizeof(hdr)) ||
+        !header_valid(hdr, static_cast<uint64_t>(st.st_size))) {
+        std::cerr << "Error: " << path << " bukan file checkpoint yang valid\n";
+        close(fd);
+        return;
+    }
+    std::vector<uint8_t> bitmap(hdr.bitmap_bytes);
+    if (pread(fd, bitmap.data(), bitmap.size(), static_cast<off_t>(hdr.bitmap_offset)) != static_cast<ssize_t>(bitmap.size()))
+        bitmap.assign(bitmap.size(), 0);
+    close(fd);
+
+    const uint64_t total = static_cast<uint64_t>(hdr.tiles_x) * hdr.tiles_y;
+    const double fraction = total ? static_cast<double>(hdr.tiles_done) / total : 0.0;
+    const int64_t age = static_cast<int64_t>(std::time(nullptr)) - hdr.updated_unix;
+    std::cout << std::fixed << std::setprecision(1)
+              << path << ": " << hdr.width << "x" << hdr.height << " (" << (hdr.is_julia ? "Julia" : "Mandelbrot")
+              << ", iterasi maks " << hdr.max_iterations << "), tile " << hdr.tile_size << "\n"
+              << "Progress: " << hdr.tiles_done << "/" << total << " tile (" << 100.0 * fraction << "%), tersimpan di disk: "
+              << hdr.tiles_persisted << "\n"
+              << "Sesi: " << hdr.sessions << ", waktu render aktif: " << hdr.active_seconds << " s, update terakhir "
+              << age << " s lalu";
+    if (hdr.finished) std::cout << " -- SELESAI\n";
+    else if (hdr.running && age > 120) std::cout << " -- proses tampaknya mati, jalankan ulang untuk melanjutkan\n";
+    else std::cout << (hdr.running ? " -- sedang berjalan\n" : " -- dijeda\n");
+    if (!hdr.finished && hdr.tiles_done > 0) {
+        // ETA dari laju rata-rata (tile di dekat batas himpunan lebih mahal, jadi ini perkiraan kasar)
+        double eta = hdr.active_seconds / hdr.tiles_done * (total - hdr.tiles_done);
+        std::cout << "ETA: " << eta << " s (" << eta / 3600.0 << " jam)\n";
+    }
+
+    // Peta tile (maks. 64x24 karakter): '#' = tersimpan, '.' = belum
+    const int map_w = std::min(hdr.tiles_x, 64), map_h = std::min(hdr.tiles_y, 24);
+    for (int my = 0; my < map_h; ++my) {
+        std::string line;
+        for (int mx = 0; mx < map_w; ++mx) {
+            int tx0 = mx * hdr.tiles_x / map_w, tx1 = std::max(tx0 + 1, (mx + 1) * hdr.tiles_x / map_w);
+            int ty0 = my * hdr.tiles_y / map_h, ty1 = std::max(ty0 + 1, (my + 1) * hdr.tiles_y / map_h);
+            int done = 0, count = 0;
+            for (int ty = ty0; ty < ty1; ++ty)
+                for (int tx = tx0; tx < tx1; ++tx, ++count) done += tile_bit(bitmap.data(), ty * hdr.tiles_x + tx);
+            line += (done == count) ? '#' : (done > 0 ? '+' : '.');
+        }
+        std::cout << "  " << line << "\n";
+    }
+}
@@ -0,0 +1,58 @@
+/**
+ * checkpoint_render.hpp
+ * Render panjang (resolusi ekstrem / zoom dalam) yang bisa dilanjutkan setelah proses mati.
+ * Data iterasi per piksel dan bitmap tile yang sudah selesai disimpan di file scratch yang
+ * di-mmap (MAP_SHARED). Run yang dijalankan ulang dengan file yang sama melewati tile yang
+ * sudah selesai. Progress dan ETA bisa dibaca dari proses lain dengan --checkpoint-status.
+ *
+ * Layout file (semua offset kelipatan ukuran halaman):
+ *   [0, 4096)            CheckpointHeader
+ *   [bitmap_offset, ...) bitmap selesai, 1 bit per tile (baris tile demi baris tile)
+ *   [data_offset, ...)   int32 jumlah iterasi per piksel, row-major width x height
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "fractal_renderer.hpp"
+
+const char CHECKPOINT_MAGIC[8] = {'F', 'R', 'C', 'K', 'P', 'T', '0', '1'};
+const uint32_t CHECKPOINT_VERSION = 1;
+const uint32_t CHECKPOINT_HEADER_BYTES = 4096;
+
+struct CheckpointHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_bytes;
+    int32_t width, height, tile_size, tiles_x, tiles_y, max_iterations, is_julia, reserved0;
+    double min_re, max_re, min_im, max_im, julia_re, julia_im;
+    uint64_t bitmap_offset, bitmap_bytes, data_offset, data_bytes, file_bytes;
+
+    // Progress; diperbarui setelah setiap batch (live) dan saat checkpoint (persisted)
+    uint64_t tiles_done;       // tile selesai di memori (termasuk yang belum di-msync)
+    uint64_t tiles_persisted;  // tile yang data + bit-nya sudah di-msync ke disk
+    double active_seconds;     // total waktu render aktif dari semua sesi
+    int64_t started_unix, updated_unix;
+    uint32_t sessions;         // jumlah run (awal + lanjutan)
+    int32_t running;           // 1 selama ada proses yang sedang merender file ini
+    int32_t finished;
+};
+
+struct CheckpointConfig {
+    std::string path;
+    int width = 1920, height = 1080;
+    int tile_size = 256;
+    float min_re = -2.0f, max_re = 1.0f, min_im = -1.2f;
+    bool is_julia = false;
+    std::complex<float> julia_c = {0, 0};
+    int max_iterations = MAX_ITERATIONS;
+    double interval_seconds = 10.0;   // jarak antar checkpoint (msync)
+    std::string output_png;           // kosong = <path tanpa ekstensi>.png
+};
+
+// Membuat file baru atau melanjutkan file yang ada (parameter diambil dari header file).
+void run_checkpoint_render(const CheckpointConfig& cfg);
+
+// Membaca header + bitmap (read-only) dan mencetak progress, ETA, dan peta tile.
+void print_checkpoint_status(const std::string& path);
@@ -0,0 +1,392 @@
+/**
+ * distributed_render.cpp
+ * Implementasi coordinator/worker. Protokol biner sederhana (host byte order, jadi coordinator
+ * dan worker harus berarsitektur sama):
+ *   worker -> coordinator : HELLO
+ *   coordinator -> worker : TASK (parameter tile) | DONE
+ *   worker -> coordinator : RESULT header + width*height*3 byte RGB
+ * Coordinator menjaga maks. PIPELINE_DEPTH task per worker agar worker tidak menganggur
+ * menunggu round-trip. Setiap tile punya tenggat (tile_timeout sejak worker bisa mulai
+ * mengerjakannya); worker yang melewatinya diputus dan tile-nya dikembalikan ke antrean.
+ */
+#include "distributed_render.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+#include <poll.h>
+
+#include "net_util.hpp"
+#include "stb_image_write.h"
+
+const int32_t MSG_HELLO = 0x31575246; // "FRW1"
+const int32_t MSG_TASK = 1;
+const int32_t MSG_DONE = 2;
+const int32_t MSG_RESULT = 3;
+const int PIPELINE_DEPTH = 2;
+const int MAX_WORKER_FAILURES = 3; // render gagal berturut-turut sebelum worker diputus
+const int MAX_TILE_FAILURES = 5;   // render gagal untuk satu tile (semua worker) sebelum tile diisi hitam
+
+struct TileTaskMsg {
+    int32_t type;
+    int32_t task_id, frame;
+    int32_t x0, y0, width, height;
+    int32_t max_iterations, is_julia;
+    float min_re, max_re, min_im, max_im, c_re, c_im;
+};
+
+struct TileResultMsg {
+    int32_t type;
+    int32_t task_id;
+    int32_t width, height;
+    int32_t ok;
+};
+
+typedef std::chrono::steady_clock::time_point TimePoint;
+
+// Seperti recv_all, tetapi gagal jika data belum lengkap saat deadline lewat
+static bool recv_all_before(int fd, void* data, size_t len, TimePoint deadline) {
+    char* p = static_cast<char*>(data);
+    while (len > 0) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        pollfd pfd = {fd, POLLIN, 0};
+        if (left.count() <= 0 || poll(&pfd, 1, static_cast<int>(std::min<long long>(left.count(), 1 << 30))) <= 0)
+            return false;
+        long n = recv_some(fd, p, len);
+        if (n <= 0) return false;
+        p += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// =======================================================================================
+// COORDINATOR
+// =======================================================================================
+
+struct FrameBuffer {
+    std::vector<uint8_t> pixels;
+    int tiles_remaining = 0;
+};
+
+class Coordinator {
+public:
+    explicit Coordinator(const CoordinatorConfig& c) : cfg(c) {}
+
+    void build_tasks() {
+        // Batas tile dibagi rata sehingga setiap tile minimal 2 piksel per sumbu
+        auto split = [](int extent, int tile) {
+            int n = std::max(1, (extent + tile - 1) / tile);
+            std::vector<int> bounds;
+            for (int i = 0; i <= n; ++i) bounds.push_back(static_cast<int>(static_cast<long long>(i) * extent / n));
+            return bounds;
+        };
+        std::vector<int> xs = split(cfg.width, cfg.tile_size), ys = split(cfg.height, cfg.tile_size);
+        tiles_per_frame = static_cast<int>((xs.size() - 1) * (ys.size() - 1));
+
+        // Frame f: zoom 2^(f/10) ke arah titik target di seahorse valley
+        const float target_re = -0.743643887f, target_im = 0.131825904f;
+        for (int f = 0; f < cfg.frames; ++f) {
+            float scale = std::pow(0.5f, f / 10.0f);
+            float re_range = 3.0f * scale;
+            float im_range = re_range * cfg.height / cfg.width;
+            float center_re = cfg.frames > 1 ? -0.5f + (target_re + 0.5f) * (1.0f - scale) : -0.5f;
+            float center_im = cfg.frames > 1 ? target_im * (1.0f - scale) : 0.0f;
+            float min_re = center_re - re_range / 2, min_im = center_im - im_range / 2;
+            float step_re = re_range / (cfg.width - 1), step_im = im_range / (cfg.height - 1);
+
+            for (size_t ty = 0; ty + 1 < ys.size(); ++ty) {
+                for (size_t tx = 0; tx + 1 < xs.size(); ++tx) {
+                    TileTaskMsg t;
+                    t.type = MSG_TASK;
+                    t.task_id = static_cast<int32_t>(tasks.size());
+                    t.frame = f;
+                    t.x0 = xs[tx]; t.y0 = ys[ty];
+                    t.width = xs[tx + 1] - xs[tx]; t.height = ys[ty + 1] - ys[ty];
+                    t.max_iterations = cfg.max_iterations;
+                    t.is_julia = 0;
+                    t.min_re = min_re + t.x0 * step_re; t.max_re = min_re + (t.x0 + t.width - 1) * step_re;
+                    t.min_im = min_im + t.y0 * step_im; t.max_im = min_im + (t.y0 + t.height - 1) * step_im;
+                    t.c_re = t.c_im = 0.0f;
+                    tasks.push_back(t);
+                    queue.push_back(t.task_id);
+                }
+            }
+        }
+        tasks_remaining = static_cast<int>(tasks.size());
+        tile_failures.assign(tasks.size(), 0);
+    }
+
+    void run() {
+        int listen_fd = tcp_listen(cfg.port);
+        if (listen_fd < 0) {
+            std::cerr << "Error: Gagal listen di port " << cfg.port << "\n";
+            return;
+        }
+        build_tasks();
+        std::cout << "Coordinator di port " << cfg.port << ": " << cfg.frames << " frame " << cfg.width << "x"
+                  << cfg.height << ", " << tasks.size() << " tile (" << tiles_per_frame << " per frame)\n";
+
+        std::vector<pid_t> children = spawn_local_workers();
+        auto start = std::chrono::steady_clock::now();
+
+        // Thread accept: setiap worker yang terhubung dilayani oleh satu thread
+        std::thread acceptor([this, listen_fd] {
+            for (;;) {
+                int fd = tcp_accept(listen_fd);
+                if (fd < 0) break;
+                std::lock_guard<std::mutex> lock(mutex);
+                if (tasks_remaining == 0) { close_socket(fd); continue; }
+                int worker_id = next_worker_id++;
+                worker_threads.emplace_back(&Coordinator::serve_worker, this, fd, worker_id);
+            }
+        });
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this] { return tasks_remaining == 0; });
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        shutdown_socket(listen_fd);
+        close_socket(listen_fd);
+        acceptor.join();
+        cv.notify_all();
+        for (auto& t : worker_threads) t.join();
+        for (pid_t pid : children) waitpid(pid, nullptr, 0);
+
+        std::cout << std::fixed << std::setprecision(2) << "Selesai dalam " << seconds << " s ("
+                  << tasks.size() / seconds << " tile/s), tile dialihkan dari worker mati: " << reassigned << "\n";
+        if (abandoned > 0) std::cout << "  " << abandoned << " tile gagal dirender " << MAX_TILE_FAILURES << " kali, diisi hitam\n";
+        for (const auto& w : tiles_by_worker) std::cout << "  worker " << w.first << ": " << w.second << " tile\n";
+    }
+
+private:
+    std::vector<pid_t> spawn_local_workers() {
+        std::vector<pid_t> children;
+        for (int i = 0; i < cfg.spawn_workers; ++i) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                std::string port = std::to_string(cfg.port);
+                execl("/proc/self/exe", "fractal_generator", "--worker", "127.0.0.1", port.c_str(), (char*)nullptr);
+                std::_Exit(127);
+            }
+            if (pid > 0) children.push_back(pid);
+        }
+        return children;
+    }
+
+    // Mengambil task berikutnya. Jika antrean kosong tetapi masih ada tile in-flight di worker lain,
+    // tunggu: tile itu mungkin dikembalikan jika worker tersebut mati.
+    bool take_task(int32_t& task_id, bool may_wait) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (may_wait) cv.wait(lock, [this] { return tasks_remaining == 0 || !queue.empty(); });
+        if (queue.empty()) return false;
+        task_id = queue.front();
+        queue.pop_front();
+        return true;
+    }
+
+    void serve_worker(int fd, int worker_id) {
+        int32_t hello = 0;
+        if (!recv_all(fd, &hello, sizeof(hello)) || hello != MSG_HELLO) { close_socket(fd); return; }
+        std::cout << "Worker " << worker_id << " terhubung\n";
+
+        std::deque<int32_t> outstanding;
+        std::deque<TimePoint> sent_at;
+        TimePoint last_result = std::chrono::steady_clock::now();
+        const auto timeout = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(cfg.tile_timeout));
+        std::vector<uint8_t> tile;
+        bool alive = true;
+        int consecutive_failures = 0;
+        for (;;) {
+            // Isi pipeline; hanya blok menunggu task jika worker sedang tidak punya pekerjaan
+            int32_t id;
+            while (alive && static_cast<int>(outstanding.size()) < PIPELINE_DEPTH && take_task(id, outstanding.empty())) {
+                if (!send_all(fd, &tasks[id], sizeof(TileTaskMsg))) { alive = false; requeue({id}); break; }
+                outstanding.push_back(id);
+                sent_at.push_back(std::chrono::steady_clock::now());
+            }
+            if (!alive || outstanding.empty()) break;
+
+            // Worker mengerjakan tile berurutan, jadi tenggat tile terdepan dihitung sejak tile itu
+            // dikirim atau sejak hasil sebelumnya diterima, mana yang lebih akhir
+            TimePoint deadline = std::max(sent_at.front(), last_result) + timeout;
+            TileResultMsg res;
+            if (!recv_all_before(fd, &res, sizeof(res), deadline) || res.type != MSG_RESULT ||
+                res.task_id != outstanding.front()) {
+                alive = false;
+                break;
+            }
+            const TileTaskMsg& t = tasks[res.task_id];
+            tile.resize(static_cast<size_t>(t.width) * t.height * 3);
+            if (!recv_all_before(fd, tile.data(), tile.size(), deadline)) { alive = false; break; }
+            outstanding.pop_front();
+            sent_at.pop_front();
+            last_result = std::chrono::steady_clock::now();
+            if (!res.ok) {
+                tile_failed(res.task_id, tile);
+                if (++consecutive_failures >= MAX_WORKER_FAILURES) {
+                    std::cerr << "Worker " << worker_id << " gagal merender " << consecutive_failures
+                              << " tile berturut-turut, diputus\n";
+                    break;
+                }
+                continue;
+            }
+            consecutive_failures = 0;
+            store_tile(t, tile, worker_id);
+        }
+
+        if (!outstanding.empty()) {
+            if (!alive)
+                std::cerr << "Worker " << worker_id << " terputus atau melewati tenggat, " << outstanding.size()
+                          << " tile dikembalikan ke antrean\n";
+            requeue(std::vector<int32_t>(outstanding.begin(), outstanding.end()));
+        }
+        if (alive) {
+            int32_t done = MSG_DONE;
+            send_all(fd, &done, sizeof(done));
+        }
+        close_socket(fd);
+    }
+
+    void requeue(const std::vector<int32_t>& ids) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int32_t id : ids) queue.push_front(id);
+        reassigned += static_cast<int>(ids.size());
+        cv.notify_all();
+    }
+
+    // Tile yang gagal dirender masuk ke belakang antrean agar tile lain tetap maju. Setelah
+    // MAX_TILE_FAILURES kegagalan tile ditutup dengan piksel hitam supaya job tetap selesai.
+    void tile_failed(int32_t id, std::vector<uint8_t>& tile) {
+        bool give_up;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            give_up = ++tile_failures[id] >= MAX_TILE_FAILURES;
+            if (give_up) abandoned++;
+            else queue.push_back(id);
+            cv.notify_all();
+        }
+        if (!give_up) return;
+        std::cerr << "Tile " << id << " gagal dirender " << MAX_TILE_FAILURES << " kali, diisi hitam\n";
+        std::fill(tile.begin(), tile.end(), 0);
+        store_tile(tasks[id], tile, -1);
+    }
+
+    // Menyalin tile ke buffer frame; frame yang lengkap langsung ditulis ke PNG lalu dibebaskan
+    void store_tile(const TileTaskMsg& t, const std::vector<uint8_t>& tile, int worker_id) {
+        FrameBuffer* frame;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            FrameBuffer& fb = frames[t.frame];
+            if (fb.pixels.empty()) {
+                fb.pixels.resize(static_cast<size_t>(cfg.width) * cfg.height * 3);
+                fb.tiles_remaining = tiles_per_frame;
+            }
+            frame = &fb;
+        }
+        for (int row = 0; row < t.height; ++row)
+            std::copy(tile.begin() + static_cast<size_t>(row) * t.width * 3,
+                      tile.begin() + static_cast<size_t>(row + 1) * t.width * 3,
+                      frame->pixels.begin() + (static_cast<size_t>(t.y0 + row) * cfg.width + t.x0) * 3);
+
+        std::vector<uint8_t> finished;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (worker_id >= 0) tiles_by_worker[worker_id]++;
+            if (--frame->tiles_remaining == 0) {
+                finished.swap(frame->pixels);
+                frames.erase(t.frame);
+            }
+        }
+        if (!finished.empty()) {
+            std::stringstream name;
+            name << cfg.output_prefix;
+            if (cfg.frames > 1) name << '_' << std::setw(4) << std::setfill('0') << t.frame;
+            name << ".png";
+            stbi_write_png(name.str().c_str(), cfg.width, cfg.height, 3, finished.data(), cfg.width * 3);
+            std::cout << "Frame " << t.frame << " selesai -> " << name.str() << "\n";
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--tasks_remaining == 0) cv.notify_all();
+        }
+    }
+
+    CoordinatorConfig cfg;
+    std::vector<TileTaskMsg> tasks;
+    std::deque<int32_t> queue;
+    int tiles_per_frame = 0;
+    int tasks_remaining = 0;
+    int reassigned = 0;
+    int abandoned = 0;
+    std::vector<int> tile_failures;
+    int next_worker_id = 0;
+    std::map<int, FrameBuffer> frames;
+    std::map<int, int> tiles_by_worker;
+    std::vector<std::thread> worker_threads;
+    std::mutex mutex;
+    std::condition_variable cv;
+};
+
+void run_coordinator(const CoordinatorConfig& cfg) {
+    Coordinator coordinator(cfg);
+    coordinator.run();
+}
+
+// =======================================================================================
+// WORKER
+// =======================================================================================
+
+void run_worker(const WorkerConfig& cfg) {
+    int fd = tcp_connect(cfg.host, cfg.port);
+    if (fd < 0) {
+        std::cerr << "Worker: gagal terhubung ke " << cfg.host << ":" << cfg.port << "\n";
+        return;
+    }
+    if (!send_all(fd, &MSG_HELLO, sizeof(MSG_HELLO))) { close_socket(fd); return; }
+
+    Renderer renderer; // konteks backend dipakai ulang untuk semua tile
+    std::vector<uint8_t> tile;
+    int tiles_done = 0;
+    for (;;) {
+        TileTaskMsg t;
+        if (!recv_all(fd, &t.type, sizeof(t.type)) || t.type != MSG_TASK) break; // DONE atau terputus
+        if (!recv_all(fd, reinterpret_cast<char*>(&t) + sizeof(t.type), sizeof(t) - sizeof(t.type))) break;
+
+        if (cfg.die_after >= 0 && tiles_done >= cfg.die_after) {
+            std::cerr << "Worker: keluar paksa setelah " << tiles_done << " tile (uji fault tolerance)\n";
+            std::_Exit(1);
+        }
+
+        RenderRequest req;
+        req.width = t.width; req.height = t.height;
+        req.min_re = t.min_re; req.max_re = t.max_re; req.min_im = t.min_im; req.max_im = t.max_im;
+        req.is_julia = t.is_julia != 0; req.julia_c = {t.c_re, t.c_im};
+        req.max_iterations = t.max_iterations;
+        req.backend = cfg.backend;
+        tile.resize(static_cast<size_t>(t.width) * t.height * 3);
+        RenderResult result = renderer.render(req, tile.data(), static_cast<size_t>(t.width) * 3);
+        if (!result.ok) std::cerr << "Worker: render gagal: " << result.error << "\n";
+
+        TileResultMsg res{MSG_RESULT, t.task_id, t.width, t.height, result.ok ? 1 : 0};
+        if (!send_all(fd, &res, sizeof(res)) || !send_all(fd, tile.data(), tile.size())) break;
+        tiles_done++;
+    }
+    close_socket(fd);
+}
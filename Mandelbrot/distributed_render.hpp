@@ -0,0 +1,33 @@
+/**
+ * distributed_render.hpp
+ * Render terdistribusi coordinator/worker lewat TCP. Coordinator memecah frame (atau rangkaian
+ * frame zoom) menjadi tile, worker menarik tile berikutnya setiap kali selesai (worker yang lebih
+ * cepat otomatis mengambil lebih banyak tile), tile milik worker yang mati atau macet (melewati
+ * tenggat per tile) dikembalikan ke antrean, dan hasil langsung dirakit ke buffer frame di coordinator.
+ */
+#pragma once
+
+#include <string>
+
+#include "fractal_renderer.hpp"
+
+struct CoordinatorConfig {
+    int port = 9090;
+    int width = 1920, height = 1080;
+    int frames = 1;              // > 1: animasi zoom ke titik target
+    int tile_size = 256;
+    int max_iterations = MAX_ITERATIONS;
+    double tile_timeout = 60.0;  // detik; tile worker yang melewati batas ini dikembalikan ke antrean
+    int spawn_workers = 0;       // jumlah worker lokal yang di-fork oleh coordinator
+    std::string output_prefix = "distributed";
+};
+
+struct WorkerConfig {
+    std::string host = "127.0.0.1";
+    int port = 9090;
+    Backend backend = Backend::OpenMP;
+    int die_after = -1;          // uji fault tolerance: keluar paksa setelah N tile (-1 = tidak)
+};
+
+void run_coordinator(const CoordinatorConfig& cfg);
+void run_worker(const WorkerConfig& cfg);
@@ -0,0 +1,230 @@
+/**
+ * expmap_zoom.cpp
+ * Implementasi strip exponential map, patch pusat, resampling frame, dan mode --expmap.
+ */
+#include "expmap_zoom.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+
+#include <omp.h>
+
+#include "stb_image_write.h"
+
+static const double TWO_PI = 6.283185307179586;
+
+// =======================================================================================
+// STRIP LOG-POLAR & PATCH PUSAT
+// =======================================================================================
+
+void generate_expmap(ExpMapStrip& strip, int strip_width, double center_re, double center_im,
+                     double r_max, double r_min, int max_iterations)
+{
+    PROFILE_SCOPE("expmap_strip");
+    const double step = TWO_PI / strip_width;
+    strip.width = strip_width;
+    strip.rows = static_cast<int>(std::ceil(std::log(r_max / r_min) / step)) + 1;
+    strip.center_re = center_re;
+    strip.center_im = center_im;
+    strip.r_max = r_max;
+    strip.r_min = r_max * std::exp(-(strip.rows - 1) * step);
+    strip.pixels.assign(static_cast<size_t>(strip.width) * strip.rows * 3, 0);
+
+    std::vector<double> cos_t(strip_width), sin_t(strip_width);
+    for (int j = 0; j < strip_width; ++j) {
+        cos_t[j] = std::cos(j * step);
+        sin_t[j] = std::sin(j * step);
+    }
+
+    // Baris dalam (radius kecil) biasanya lebih mahal karena dekat batas himpunan -> dynamic
+    #pragma omp parallel for schedule(dynamic)
+    for (int k = 0; k < strip.rows; ++k) {
+        double rho = r_max * std::exp(-k * step);
+        uint8_t* row = &strip.pixels[static_cast<size_t>(k) * strip.width * 3];
+        for (int j = 0; j < strip.width; ++j) {
+            // Kernel bersama dalam double: zoom video jauh melewati resolusi float generator lain
+            int iterations = escape_iterations<double>({0.0, 0.0}, {center_re + rho * cos_t[j], center_im + rho * sin_t[j]},
+                                                       max_iterations);
+            Color color = map_iteration_to_color(iterations, max_iterations);
+            row[j * 3] = color.r; row[j * 3 + 1] = color.g; row[j * 3 + 2] = color.b;
+        }
+    }
+}
+
+void generate_center_patch(CenterPatch& patch, int size, double spacing,
+                           double center_re, double center_im, int max_iterations)
+{
+    PROFILE_SCOPE("expmap_center_patch");
+    patch.size = size;
+    patch.spacing = spacing;
+    patch.pixels.assign(static_cast<size_t>(size) * size * 3, 0);
+    #pragma omp parallel for schedule(dynamic)
+    for (int py = 0; py < size; ++py) {
+        for (int px = 0; px < size; ++px) {
+            double c_re = center_re + (px + 0.5 - size * 0.5) * spacing;
+            double c_im = center_im + (py + 0.5 - size * 0.5) * spacing;
+            Color color = map_iteration_to_color(escape_iterations<double>({0.0, 0.0}, {c_re, c_im}, max_iterations),
+                                                 max_iterations);
+            size_t index = (static_cast<size_t>(py) * size + px) * 3;
+            patch.pixels[index] = color.r; patch.pixels[index + 1] = color.g; patch.pixels[index + 2] = color.b;
+        }
+    }
+}
+
+// =======================================================================================
+// RESAMPLING FRAME
+// =======================================================================================
+
+// Bilinear di strip: sudut dibungkus (wrap), log radius di-clamp ke baris yang ada
+static inline void sample_strip(const ExpMapStrip& s, double dx, double dy, float rgb[3]) {
+    const double inv_step = s.width / TWO_PI;
+    double rho = std::max(std::sqrt(dx * dx + dy * dy), s.r_min);
+    double theta = std::atan2(dy, dx);
+    if (theta < 0) theta += TWO_PI;
+    double u = theta * inv_step;
+    double v = std::min(std::log(s.r_max / rho) * inv_step, static_cast<double>(s.rows - 1));
+    v = std::max(v, 0.0);
+    int j0 = static_cast<int>(u), k0 = static_cast<int>(v);
+    float fu = static_cast<float>(u - j0), fv = static_cast<float>(v - k0);
+    j0 %= s.width;
+    int j1 = (j0 + 1) % s.width, k1 = std::min(k0 + 1, s.rows - 1);
+    const uint8_t* a = &s.pixels[(static_cast<size_t>(k0) * s.width + j0) * 3];
+    const uint8_t* b = &s.pixels[(static_cast<size_t>(k0) * s.width + j1) * 3];
+    const uint8_t* c = &s.pixels[(static_cast<size_t>(k1) * s.width + j0) * 3];
+    const uint8_t* d = &s.pixels[(static_cast<size_t>(k1) * s.width + j1) * 3];
+    for (int ch = 0; ch < 3; ++ch) {
+        float top = a[ch] + (b[ch] - a[ch]) * fu;
+        float bottom = c[ch] + (d[ch] - c[ch]) * fu;
+        rgb[ch] = top + (bottom - top) * fv;
+    }
+}
+
+static inline void sample_patch(const CenterPatch& p, double dx, double dy, float rgb[3]) {
+    double u = dx / p.spacing + p.size * 0.5 - 0.5, v = dy / p.spacing + p.size * 0.5 - 0.5;
+    u = std::min(std::max(u, 0.0), p.size - 1.0);
+    v = std::min(std::max(v, 0.0), p.size - 1.0);
+    int x0 = std::min(static_cast<int>(u), p.size - 2), y0 = std::min(static_cast<int>(v), p.size - 2);
+    float fu = static_cast<float>(u - x0), fv = static_cast<float>(v - y0);
+    const uint8_t* a = &p.pixels[(static_cast<size_t>(y0) * p.size + x0) * 3];
+    const uint8_t* b = a + 3;
+    const uint8_t* c = a + static_cast<size_t>(p.size) * 3;
+    const uint8_t* d = c + 3;
+    for (int ch = 0; ch < 3; ++ch) {
+        float top = a[ch] + (b[ch] - a[ch]) * fu;
+        float bottom = c[ch] + (d[ch] - c[ch]) * fu;
+        rgb[ch] = top + (bottom - top) * fv;
+    }
+}
+
+void resample_expmap_frame(const ExpMapStrip& strip, const CenterPatch* patch, double radius,
+                           uint8_t* out, int width, int height)
+{
+    PROFILE_SCOPE("expmap_resample");
+    const double spacing = 2.0 * radius / height;
+    const double patch_half = (patch && patch->size >= 2) ? (patch->size * 0.5 - 1.0) * patch->spacing : 0.0;
+    const double strip_step = TWO_PI / strip.width;
+
+    #pragma omp parallel for schedule(dynamic, 4)
+    for (int py = 0; py < height; ++py) {
+        for (int px = 0; px < width; ++px) {
+            double dx = (px + 0.5 - width * 0.5) * spacing;
+            double dy = (py + 0.5 - height * 0.5) * spacing;
+            bool in_patch = std::abs(dx) < patch_half && std::abs(dy) < patch_half;
+            // Jumlah sampel per sumbu sesuai luas jejak piksel di sumber, agar area yang
+            // oversampled (dekat pusat) tidak aliasing
+            double source_step = in_patch ? patch->spacing : std::sqrt(dx * dx + dy * dy) * strip_step;
+            int taps = static_cast<int>(std::ceil(spacing / std::max(source_step, 1e-300)));
+            taps = std::min(std::max(taps, 1), 4);
+
+            float sum[3] = {0, 0, 0}, rgb[3];
+            for (int sy = 0; sy < taps; ++sy) {
+                for (int sx = 0; sx < taps; ++sx) {
+                    double ox = dx + ((sx + 0.5) / taps - 0.5) * spacing;
+                    double oy = dy + ((sy + 0.5) / taps - 0.5) * spacing;
+                    if (in_patch) sample_patch(*patch, ox, oy, rgb);
+                    else sample_strip(strip, ox, oy, rgb);
+                    sum[0] += rgb[0]; sum[1] += rgb[1]; sum[2] += rgb[2];
+                }
+            }
+            float inv = 1.0f / (taps * taps);
+            uint8_t* dst = out + (static_cast<size_t>(py) * width + px) * 3;
+            for (int ch = 0; ch < 3; ++ch) dst[ch] = static_cast<uint8_t>(std::min(255.0f, sum[ch] * inv + 0.5f));
+        }
+    }
+}
+
+// =======================================================================================
+// MODE --expmap
+// =======================================================================================
+
+void run_expmap_zoom(const ExpMapConfig& cfg) {
+    const int w = cfg.width, h = cfg.height;
+    const double half_diagonal_px = 0.5 * std::sqrt(static_cast<double>(w) * w + static_cast<double>(h) * h);
+    // Otomatis: satu sampel sudut per piksel di sudut frame (bagian yang paling jarang disampling)
+    int strip_width = cfg.strip_width > 0 ? cfg.strip_width
+                                          : static_cast<int>(std::ceil(TWO_PI * half_diagonal_px / 8.0)) * 8;
+    const double r_max = cfg.start_radius * half_diagonal_px / (h * 0.5) * 1.01;
+    const double last_spacing = 2.0 * cfg.end_radius / h;
+    // Tanpa patch strip turun hingga setengah piksel frame terakhir; dengan patch cukup hingga
+    // setengah ukuran patch (sisanya ditutup patch)
+    const double r_min = cfg.patch_size > 0 ? std::max(0.25 * cfg.patch_size * last_spacing, 0.5 * last_spacing)
+                                            : 0.5 * last_spacing;
+
+    std::cout << "Exponential map zoom: " << cfg.frames << " frame " << w << "x" << h << ", pusat ("
+              << std::setprecision(15) << cfg.center_re << ", " << cfg.center_im << "), radius "
+              << std::setprecision(3) << std::scientific << cfg.start_radius << " -> " << cfg.end_radius
+              << std::defaultfloat << ", iterasi maks " << cfg.max_iterations << "\n";
+
+    ExpMapStrip strip;
+    auto start_strip = std::chrono::steady_clock::now();
+    generate_expmap(strip, strip_width, cfg.center_re, cfg.center_im, r_max, r_min, cfg.max_iterations);
+    double strip_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_strip).count();
+
+    CenterPatch patch;
+    double patch_ms = 0.0;
+    if (cfg.patch_size > 0) {
+        auto start_patch = std::chrono::steady_clock::now();
+        generate_center_patch(patch, std::max(2, cfg.patch_size), last_spacing, cfg.center_re, cfg.center_im, cfg.max_iterations);
+        patch_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_patch).count();
+    }
+
+    double samples = static_cast<double>(strip.width) * strip.rows + static_cast<double>(patch.size) * patch.size;
+    std::cout << std::fixed << std::setprecision(2)
+              << "Strip: " << strip.width << " x " << strip.rows << " (" << strip.pixels.size() / 1048576.0 << " MiB), "
+              << strip_ms << " ms";
+    if (patch.size > 0) std::cout << "; patch pusat " << patch.size << "x" << patch.size << ", " << patch_ms << " ms";
+    std::cout << "\nBiaya render setara " << samples / (static_cast<double>(w) * h) << " frame penuh (vs "
+              << cfg.frames << " frame jika dirender satu per satu)\n";
+
+    if (cfg.save_strip) {
+        std::string strip_path = cfg.output_prefix + "_expmap.png";
+        stbi_write_png(strip_path.c_str(), strip.width, strip.rows, 3, strip.pixels.data(), strip.width * 3);
+        std::cout << "Strip disimpan: " << strip_path << "\n";
+    }
+
+    std::vector<uint8_t> frame(static_cast<size_t>(w) * h * 3);
+    double resample_ms = 0.0, write_ms = 0.0;
+    char name[64];
+    for (int f = 0; f < cfg.frames; ++f) {
+        double t = cfg.frames > 1 ? static_cast<double>(f) / (cfg.frames - 1) : 0.0;
+        double radius = cfg.start_radius * std::pow(cfg.end_radius / cfg.start_radius, t);
+        auto start_frame = std::chrono::steady_clock::now();
+        resample_expmap_frame(strip, patch.size > 0 ? &patch : nullptr, radius, frame.data(), w, h);
+        auto end_frame = std::chrono::steady_clock::now();
+        std::snprintf(name, sizeof(name), "_%05d.png", f);
+        stbi_write_png((cfg.output_prefix + name).c_str(), w, h, 3, frame.data(), w * 3);
+        resample_ms += std::chrono::duration<double, std::milli>(end_frame - start_frame).count();
+        write_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - end_frame).count();
+        if ((f + 1) % 100 == 0 || f + 1 == cfg.frames)
+            std::cout << "\rFrame " << f + 1 << "/" << cfg.frames << std::flush;
+    }
+    std::cout << "\nResampling: " << resample_ms / std::max(1, cfg.frames) << " ms/frame, tulis PNG: "
+              << write_ms / std::max(1, cfg.frames) << " ms/frame, total "
+              << (strip_ms + patch_ms + resample_ms + write_ms) / 1e3 << " s\n"
+              << "Output: " << cfg.output_prefix << "_00000.png ... (ffmpeg -i " << cfg.output_prefix
+              << "_%05d.png zoom.mp4)\n";
+}
@@ -0,0 +1,56 @@
+/**
+ * expmap_zoom.hpp
+ * Video zoom murah lewat exponential map (log-polar): satu strip dirender sekali, kolom = sudut,
+ * baris = log radius dari titik pusat zoom. Setiap frame video kemudian hanya resampling strip
+ * tersebut (ditambah patch pusat beresolusi penuh yang opsional), sehingga biaya ribuan frame
+ * kira-kira setara beberapa render resolusi penuh.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "fractal_renderer.hpp"
+
+struct ExpMapConfig {
+    int width = 1280, height = 720;   // resolusi frame video
+    int frames = 600;
+    double center_re = -0.743643887037151, center_im = 0.131825904205330;
+    double start_radius = 1.5;        // setengah tinggi view frame pertama
+    double end_radius = 1e-5;         // setengah tinggi view frame terakhir
+    int strip_width = 0;              // jumlah sampel sudut; 0 = otomatis (sampling ~1:1 di sudut frame)
+    int patch_size = 0;               // > 0: patch pusat patch_size x patch_size piksel dari frame terakhir
+    int max_iterations = 2000;
+    bool save_strip = false;          // simpan strip sebagai <prefix>_expmap.png
+    std::string output_prefix = "expzoom";
+};
+
+// Strip log-polar berwarna (RGB). Baris k berada di radius r_max * exp(-k * 2*pi / width),
+// kolom j di sudut j * 2*pi / width, sehingga sampel berbentuk persegi di ruang log-polar.
+struct ExpMapStrip {
+    int width = 0, rows = 0;
+    double center_re = 0, center_im = 0;
+    double r_max = 0, r_min = 0;
+    std::vector<uint8_t> pixels;
+};
+
+// Patch pusat persegi (RGB) dengan jarak sampel `spacing` di bidang kompleks.
+struct CenterPatch {
+    int size = 0;
+    double spacing = 0;
+    std::vector<uint8_t> pixels;
+};
+
+// Merender strip dengan OpenMP (presisi double agar zoom bisa lebih dalam dari renderer float).
+void generate_expmap(ExpMapStrip& strip, int strip_width, double center_re, double center_im,
+                     double r_max, double r_min, int max_iterations);
+
+void generate_center_patch(CenterPatch& patch, int size, double spacing,
+                           double center_re, double center_im, int max_iterations);
+
+// Satu frame video dengan setengah tinggi view `radius`, dihasilkan dari strip (+ patch jika ada).
+void resample_expmap_frame(const ExpMapStrip& strip, const CenterPatch* patch, double radius,
+                           uint8_t* out, int width, int height);
+
+void run_expmap_zoom(const ExpMapConfig& cfg);
@@ -0,0 +1,133 @@
+/**
+ * fractal_profiler.hpp
+ * Instrumentasi ringan untuk renderer: timer bercakupan (PROFILE_SCOPE), counter per frame,
+ * waktu sibuk per thread, dan export Chrome trace JSON.
+ * Saat nonaktif, setiap titik instrumentasi hanya berupa satu cek bool. Saat aktif, durasi
+ * tahap dan counter dikumpulkan per frame; event trace hanya disimpan jika record_trace aktif.
+ */
+#pragma once
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <omp.h>
+
+const int TRACE_TID_DEVICE = 1000; // jalur trace untuk durasi sisi device OpenCL
+
+struct TraceEvent {
+    std::string name;
+    char phase;     // 'X' = durasi, 'C' = counter
+    int tid;
+    double ts_us;
+    double value;   // durasi (us) untuk 'X', nilai counter untuk 'C'
+};
+
+struct FrameStats {
+    double frame_ms = 0.0;
+    long long iterations = 0, escaped = 0, interior = 0;
+    std::vector<std::pair<std::string, double>> stages; // urutan kemunculan, ms
+    std::vector<double> thread_busy_ms;
+
+    double iterations_per_sec() const { return frame_ms > 0 ? iterations / (frame_ms * 1e-3) : 0.0; }
+};
+
+struct Profiler {
+    bool enabled = false;
+    bool record_trace = false;
+    std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point frame_start;
+    std::mutex mutex;
+    std::vector<TraceEvent> events;
+    FrameStats current, last_frame;
+
+    double now_us() const {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - origin).count();
+    }
+
+    void begin_frame() {
+        if (!enabled) return;
+        std::lock_guard<std::mutex> lock(mutex);
+        current = FrameStats();
+        frame_start = std::chrono::steady_clock::now();
+    }
+
+    void end_frame() {
+        if (!enabled) return;
+        std::lock_guard<std::mutex> lock(mutex);
+        current.frame_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frame_start).count();
+        if (record_trace) {
+            double ts = now_us();
+            events.push_back({"iterations", 'C', 0, ts, static_cast<double>(current.iterations)});
+            events.push_back({"escaped_pixels", 'C', 0, ts, static_cast<double>(current.escaped)});
+            events.push_back({"interior_pixels", 'C', 0, ts, static_cast<double>(current.interior)});
+            events.push_back({"iterations_per_sec", 'C', 0, ts, current.iterations_per_sec()});
+        }
+        last_frame = current;
+    }
+
+    void add_stage(const std::string& name, double start_us, double dur_us, int tid = 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        bool found = false;
+        for (auto& st : current.stages)
+            if (st.first == name) { st.second += dur_us * 1e-3; found = true; break; }
+        if (!found) current.stages.push_back({name, dur_us * 1e-3});
+        if (record_trace) events.push_back({name, 'X', tid, start_us, dur_us});
+    }
+
+    void add_thread_busy(int tid, double start_us, double dur_us) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (static_cast<int>(current.thread_busy_ms.size()) <= tid) current.thread_busy_ms.resize(tid + 1, 0.0);
+        current.thread_busy_ms[tid] += dur_us * 1e-3;
+        if (record_trace) events.push_back({"thread_busy", 'X', tid, start_us, dur_us});
+    }
+
+    void add_pixel_counts(long long iterations, long long escaped, long long interior) {
+        std::lock_guard<std::mutex> lock(mutex);
+        current.iterations += iterations;
+        current.escaped += escaped;
+        current.interior += interior;
+    }
+
+    void write_chrome_trace(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::ofstream out(path);
+        if (!out) { std::cerr << "Error: Gagal menulis trace " << path << "\n"; return; }
+        out << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+        out << "  {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 0, \"args\": {\"name\": \"fractal_generator\"}}";
+        out << ",\n  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << TRACE_TID_DEVICE
+            << ", \"args\": {\"name\": \"OpenCL device\"}}";
+        for (const TraceEvent& e : events) {
+            out << ",\n  {\"name\": \"" << e.name << "\", \"ph\": \"" << e.phase << "\", \"pid\": 1, \"tid\": " << e.tid
+                << ", \"ts\": " << e.ts_us;
+            if (e.phase == 'X') out << ", \"dur\": " << e.value << "}";
+            else out << ", \"args\": {\"value\": " << e.value << "}}";
+        }
+        out << "\n]}\n";
+        std::cout << "Trace ditulis ke " << path << " (" << events.size() << " event)\n";
+    }
+};
+
+// Satu instance global, didefinisikan di fractal_renderer.cpp
+extern Profiler g_profiler;
+
+// Mengukur durasi blok sebagai satu tahap frame. Tidak melakukan apa pun jika profiler nonaktif.
+struct ScopedTimer {
+    const char* name;
+    double start_us = -1.0;
+    explicit ScopedTimer(const char* n) : name(n) {
+        if (g_profiler.enabled) start_us = g_profiler.now_us();
+    }
+    ~ScopedTimer() {
+        if (start_us >= 0.0) g_profiler.add_stage(name, start_us, g_profiler.now_us() - start_us, omp_get_thread_num());
+    }
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ScopedTimer PROFILE_CONCAT(scoped_timer_, __LINE__)(name)
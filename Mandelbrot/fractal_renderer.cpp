@@ -0,0 +1,723 @@
+/**
+ * fractal_renderer.cpp
+ * Implementasi library rendering fraktal: generator Serial/OpenMP/OpenCL, atlas Julia,
+ * Buddhabrot, dan Renderer dengan submit async.
+ */
+#include "fractal_renderer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include <omp.h>
+
+Profiler g_profiler;
+
+// =======================================================================================
+// FUNGSI-FUNGSI GENERATOR FRAKTAL (SERIAL, PARALEL, GPU)
+// =======================================================================================
+
+// --- Implementasi Serial ---
+void generate_fractal_serial(
+    uint8_t* pixels, size_t stride, int width, int height,
+    float min_re, float max_re, float min_im, float max_im,
+    bool is_julia, std::complex<float> julia_c, int max_iterations,
+    int32_t* iterations_out)
+{
+    PROFILE_SCOPE("compute_serial");
+    float re_range = max_re - min_re;
+    float im_range = max_im - min_im;
+    long long total_iterations = 0, escaped = 0;
+
+    for (int py = 0; py < height; ++py) {
+        for (int px = 0; px < width; ++px) {
+            float cx = min_re + static_cast<float>(px) / (width - 1) * re_range;
+            float cy = min_im + static_cast<float>(py) / (height - 1) * im_range;
+
+            int iterations = point_iterations(cx, cy, is_julia, julia_c, max_iterations);
+            total_iterations += iterations;
+            escaped += (iterations < max_iterations);
+            if (iterations_out) iterations_out[static_cast<size_t>(py) * width + px] = iterations;
+
+            Color color = map_iteration_to_color(iterations, max_iterations);
+            size_t index = py * stride + px * 3;
+            pixels[index]     = color.r;
+            pixels[index + 1] = color.g;
+            pixels[index + 2] = color.b;
+        }
+    }
+    if (g_profiler.enabled) g_profiler.add_pixel_counts(total_iterations, escaped, static_cast<long long>(width) * height - escaped);
+}
+
+
+// --- Implementasi Paralel CPU ---
+void generate_fractal_parallel(
+    uint8_t* pixels, size_t stride, int width, int height,
+    float min_re, float max_re, float min_im, float max_im,
+    bool is_julia, std::complex<float> julia_c, int max_iterations,
+    int32_t* iterations_out)
+{
+    PROFILE_SCOPE("compute_openmp");
+    float re_range = max_re - min_re;
+    float im_range = max_im - min_im;
+    long long total_iterations = 0, escaped = 0;
+
+    #pragma omp parallel reduction(+:total_iterations, escaped)
+    {
+    double thread_start_us = g_profiler.enabled ? g_profiler.now_us() : 0.0;
+    #pragma omp for schedule(dynamic) nowait
+    for (int py = 0; py < height; ++py) {
+        for (int px = 0; px < width; ++px) {
+            float cx = min_re + static_cast<float>(px) / (width - 1) * re_range;
+            float cy = min_im + static_cast<float>(py) / (height - 1) * im_range;
+
+            int iterations = point_iterations(cx, cy, is_julia, julia_c, max_iterations);
+            total_iterations += iterations;
+            escaped += (iterations < max_iterations);
+            if (iterations_out) iterations_out[static_cast<size_t>(py) * width + px] = iterations;
+
+            Color color = map_iteration_to_color(iterations, max_iterations);
+            size_t index = py * stride + px * 3;
+            pixels[index]     = color.r;
+            pixels[index + 1] = color.g;
+            pixels[index + 2] = color.b;
+        }
+    }
+    if (g_profiler.enabled) g_profiler.add_thread_busy(omp_get_thread_num(), thread_start_us, g_profiler.now_us() - thread_start_us);
+    }
+    if (g_profiler.enabled) g_profiler.add_pixel_counts(total_iterations, escaped, static_cast<long long>(width) * height - escaped);
+}
+
+// --- Implementasi GPU ---
+#ifdef ENABLE_OPENCL
+double event_duration_ms(const cl::Event& event) {
+    cl_ulong start = event.getProfilingInfo<CL_PROFILING_COMMAND_START>();
+    cl_ulong end = event.getProfilingInfo<CL_PROFILING_COMMAND_END>();
+    return static_cast<double>(end - start) * 1e-6;
+}
+
+void init_opencl_context(OpenCLContext& ctx, const std::string& kernel_path) {
+    std::vector<cl::Platform> platforms;
+    cl::Platform::get(&platforms);
+    if (platforms.empty()) throw std::runtime_error("No OpenCL platform found.");
+
+    cl::Device device;
+    for(auto& p : platforms) {
+        std::vector<cl::Device> p_devices;
+        p.getDevices(CL_DEVICE_TYPE_GPU, &p_devices);
+        if(!p_devices.empty()) {
+            device = p_devices.front();
+            break;
+        }
+    }
+    if(!device()) { // Fallback to CPU if no GPU found
+        for(auto& p : platforms) {
+            std::vector<cl::Device> p_devices;
+            p.getDevices(CL_DEVICE_TYPE_CPU, &p_devices);
+            if(!p_devices.empty()) {
+                device = p_devices.front();
+                break;
+            }
+        }
+    }
+    if(!device()) throw std::runtime_error("No OpenCL device found.");
+
+    // CL_DEVICE_HOST_UNIFIED_MEMORY dibaca lewat API C karena trait-nya di opencl.hpp ikut deprecated sejak 2.0
+    cl_bool unified = CL_FALSE;
+    clGetDeviceInfo(device(), CL_DEVICE_HOST_UNIFIED_MEMORY, sizeof(unified), &unified, nullptr);
+    std::cout << "[OpenCL] Using device: " << device.getInfo<CL_DEVICE_NAME>()
+              << (unified == CL_TRUE ? " (host unified memory, band di-map tanpa salinan)" : "") << std::endl;
+
+    ctx.device = device;
+    ctx.host_unified_memory = (unified == CL_TRUE);
+    ctx.context = cl::Context(device);
+    ctx.queue = cl::CommandQueue(ctx.context, device, CL_QUEUE_PROFILING_ENABLE);
+    ctx.transfer_queue = cl::CommandQueue(ctx.context, device, CL_QUEUE_PROFILING_ENABLE);
+    ctx.band_buffers.clear();
+    ctx.band_buffer_bytes = 0;
+
+    std::ifstream kernel_file(kernel_path);
+    if (!kernel_file.is_open()) throw std::runtime_error("Failed to open kernel file.");
+    std::string kernel_code(std::istreambuf_iterator<char>(kernel_file), (std::istreambuf_iterator<char>()));
+
+    ctx.program = cl::Program(ctx.context, kernel_code);
+    try {
+        ctx.program.build({device});
+    } catch (const cl::Error& e) {
+        if (e.err() == CL_BUILD_PROGRAM_FAILURE) {
+            std::cerr << "=== OpenCL Build Log ===\n" << ctx.program.getBuildInfo<CL_PROGRAM_BUILD_LOG>(device) << "\n";
+        }
+        throw;
+    }
+    ctx.kernel = cl::Kernel(ctx.program, "generate_fractal");
+    ctx.atlas_kernel = cl::Kernel(ctx.program, "generate_julia_atlas");
+}
+
+// Pipeline per band dengan BAND_SLOTS buffer bergilir:
+//   queue          : kernel band N (menunggu unmap slot yang sama dari band N - BAND_SLOTS)
+//   transfer_queue : map band N (menunggu kernel band N) -> host colorize langsung dari pointer map -> unmap
+// Host mulai mewarnai band N begitu map-nya selesai, sementara device sudah menghitung band berikutnya.
+static const int BAND_SLOTS = 3;
+
+void generate_fractal_gpu(
+    OpenCLContext& ctx, uint8_t* pixels, size_t stride, int width, int height,
+    float min_re, float max_re, float min_im, float max_im,
+    bool is_julia, std::complex<float> julia_c, int max_iterations, GpuTimings* timings,
+    int32_t* iterations_out)
+{
+    PROFILE_SCOPE("compute_opencl");
+    auto start_wall = std::chrono::steady_clock::now();
+    // Jumlah band dihitung ulang dari band_rows agar tidak ada band kosong (NDRange / map 0 byte
+    // ditolak OpenCL), misalnya height 10 dengan 8 band -> 2 baris per band -> 5 band
+    const int requested_bands = std::max(1, std::min(ctx.bands, height));
+    const int band_rows = (height + requested_bands - 1) / requested_bands;
+    const int bands = (height + band_rows - 1) / band_rows;
+    const size_t slot_bytes = sizeof(int) * static_cast<size_t>(width) * band_rows;
+    if (ctx.band_buffers.size() != BAND_SLOTS || ctx.band_buffer_bytes < slot_bytes) {
+        ctx.band_buffers.clear();
+        for (int i = 0; i < BAND_SLOTS; ++i)
+            ctx.band_buffers.emplace_back(ctx.context, CL_MEM_WRITE_ONLY | CL_MEM_ALLOC_HOST_PTR, slot_bytes);
+        ctx.band_buffer_bytes = slot_bytes;
+    }
+
+    cl::Kernel& kernel = ctx.kernel;
+    kernel.setArg(1, width); kernel.setArg(2, height);
+    kernel.setArg(3, min_re); kernel.setArg(4, max_re); kernel.setArg(5, min_im); kernel.setArg(6, max_im);
+    kernel.setArg(7, max_iterations); kernel.setArg(8, static_cast<int>(is_julia));
+    kernel.setArg(9, julia_c.real()); kernel.setArg(10, julia_c.imag());
+
+    std::vector<cl::Event> kernel_events(bands), map_events(bands), unmap_events(BAND_SLOTS);
+    std::vector<bool> slot_used(BAND_SLOTS, false);
+    std::vector<int*> mapped(bands, nullptr);
+    auto band_first_row = [&](int b) { return b * band_rows; };
+    auto band_row_count = [&](int b) { return std::max(0, std::min(band_rows, height - b * band_rows)); };
+
+    auto enqueue_band = [&](int b) {
+        int slot = b % BAND_SLOTS;
+        int rows = band_row_count(b);
+        std::vector<cl::Event> wait_unmap;
+        if (slot_used[slot]) wait_unmap.push_back(unmap_events[slot]);
+        kernel.setArg(0, ctx.band_buffers[slot]);
+        kernel.setArg(11, band_first_row(b));
+        kernel.setArg(12, rows);
+        ctx.queue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(static_cast<size_t>(width) * rows), cl::NullRange,
+                                       wait_unmap.empty() ? nullptr : &wait_unmap, &kernel_events[b]);
+        ctx.queue.flush();
+        std::vector<cl::Event> wait_kernel = {kernel_events[b]};
+        mapped[b] = static_cast<int*>(ctx.transfer_queue.enqueueMapBuffer(
+            ctx.band_buffers[slot], CL_FALSE, CL_MAP_READ, 0, sizeof(int) * static_cast<size_t>(width) * rows,
+            &wait_kernel, &map_events[b]));
+        ctx.transfer_queue.flush();
+        slot_used[slot] = true;
+    };
+
+    long long total_iterations = 0, escaped = 0;
+    double colorize_ms = 0.0, trace_origin_us = g_profiler.enabled ? g_profiler.now_us() : 0.0;
+    {
+        PROFILE_SCOPE("gpu_band_pipeline");
+        for (int b = 0; b < std::min(bands, BAND_SLOTS); ++b) enqueue_band(b);
+        for (int b = 0; b < bands; ++b) {
+            map_events[b].wait();
+            auto start_colorize = std::chrono::steady_clock::now();
+            const int first_row = band_first_row(b), rows = band_row_count(b);
+            const int* band = mapped[b];
+            {
+                PROFILE_SCOPE("colorize_band");
+                #pragma omp parallel for reduction(+:total_iterations, escaped)
+                for (int r = 0; r < rows; ++r) {
+                    const int* row = band + static_cast<size_t>(r) * width;
+                    uint8_t* out = pixels + (first_row + r) * stride;
+                    if (iterations_out)
+                        std::copy(row, row + width, iterations_out + static_cast<size_t>(first_row + r) * width);
+                    for (int px = 0; px < width; ++px) {
+                        Color color = map_iteration_to_color(row[px], max_iterations);
+                        out[px * 3] = color.r; out[px * 3 + 1] = color.g; out[px * 3 + 2] = color.b;
+                        total_iterations += row[px];
+                        escaped += (row[px] < max_iterations);
+                    }
+                }
+            }
+            colorize_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_colorize).count();
+            int slot = b % BAND_SLOTS;
+            ctx.transfer_queue.enqueueUnmapMemObject(ctx.band_buffers[slot], mapped[b], nullptr, &unmap_events[slot]);
+            ctx.transfer_queue.flush();
+            if (b + BAND_SLOTS < bands) enqueue_band(b + BAND_SLOTS);
+        }
+        ctx.transfer_queue.finish();
+        ctx.queue.finish();
+    }
+    double wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_wall).count();
+
+    GpuTimings tm;
+    tm.bands = bands;
+    for (int b = 0; b < bands; ++b) {
+        tm.kernel_ms += event_duration_ms(kernel_events[b]);
+        tm.readback_ms += event_duration_ms(map_events[b]);
+    }
+    tm.colorize_ms = colorize_ms;
+    tm.overlap_ms = std::max(0.0, tm.kernel_ms + tm.readback_ms + tm.colorize_ms - wall_ms);
+    if (timings) *timings = tm;
+    if (g_profiler.enabled) {
+        // Durasi sisi device dari event profiling, ditempatkan relatif terhadap awal kernel band pertama
+        cl_ulong origin = kernel_events[0].getProfilingInfo<CL_PROFILING_COMMAND_START>();
+        for (int b = 0; b < bands; ++b) {
+            const cl::Event* events[2] = {&kernel_events[b], &map_events[b]};
+            const char* names[2] = {"gpu_kernel_device", "gpu_readback_device"};
+            for (int k = 0; k < 2; ++k) {
+                cl_ulong ev_start = events[k]->getProfilingInfo<CL_PROFILING_COMMAND_START>();
+                double start_us = trace_origin_us + (ev_start >= origin ? (ev_start - origin) * 1e-3 : 0.0);
+                g_profiler.add_stage(names[k], start_us, event_duration_ms(*events[k]) * 1e3, TRACE_TID_DEVICE);
+            }
+        }
+        g_profiler.add_pixel_counts(total_iterations, escaped, static_cast<long long>(width) * height - escaped);
+    }
+}
+
+void generate_fractal_gpu(
+    std::vector<uint8_t>& pixels, int width, int height,
+    float min_re, float max_re, float min_im, float max_im,
+    bool is_julia, std::complex<float> julia_c)
+{
+    static OpenCLContext ctx;
+    static bool ctx_ready = false;
+    try {
+        if (!ctx_ready) {
+            init_opencl_context(ctx);
+            ctx_ready = true;
+        }
+        generate_fractal_gpu(ctx, pixels, width, height, min_re, max_re, min_im, max_im, is_julia, julia_c);
+    } catch (const cl::Error& e) {
+        std::cerr << "OpenCL Error: " << e.what() << " (" << e.err() << ")\n";
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Runtime Error: " << e.what() << '\n';
+    }
+}
+#endif
+
+// =======================================================================================
+// DATA ITERASI MENTAH
+// =======================================================================================
+
+void generate_iterations_region(
+    int32_t* out, size_t out_stride, int frame_w, int frame_h, int x0, int y0, int w, int h,
+    float min_re, float max_re, float min_im, float max_im,
+    bool is_julia, std::complex<float> julia_c, int max_iterations)
+{
+    float re_range = max_re - min_re;
+    float im_range = max_im - min_im;
+    for (int ty = 0; ty < h; ++ty) {
+        int py = y0 + ty;
+        float cy = min_im + static_cast<float>(py) / (frame_h - 1) * im_range;
+        int32_t* row = out + ty * out_stride;
+        for (int tx = 0; tx < w; ++tx) {
+            int px = x0 + tx;
+            float cx = min_re + static_cast<float>(px) / (frame_w - 1) * re_range;
+            row[tx] = point_iterations(cx, cy, is_julia, julia_c, max_iterations);
+        }
+    }
+}
+
+void generate_iteration_field_parallel(
+    int32_t* iterations_out, float* smooth_out, float* norm_out, int width, int height,
+    float min_re, float max_re, float min_im, float max_im,
+    bool is_julia, std::complex<float> julia_c, int max_iterations)
+{
+    PROFILE_SCOPE("iteration_field");
+    float re_range = max_re - min_re;
+    float im_range = max_im - min_im;
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int py = 0; py < height; ++py) {
+        float cy = min_im + static_cast<float>(py) / (height - 1) * im_range;
+        size_t row = static_cast<size_t>(py) * width;
+        for (int px = 0; px < width; ++px) {
+            float cx = min_re + static_cast<float>(px) / (width - 1) * re_range;
+
+            float norm;
+            int iterations = point_iterations(cx, cy, is_julia, julia_c, max_iterations, &norm);
+            if (iterations_out) iterations_out[row + px] = iterations;
+            if (norm_out) norm_out[row + px] = norm;
+            if (smooth_out) {
+                // log2(log2|z|) = log2(0.5 * log2|z|^2); bailout 2 -> nilai di rentang (n, n + 1]
+                smooth_out[row + px] = (iterations < max_iterations && norm > 1.0f)
+                    ? iterations + 1.0f - std::log2(0.5f * std::log2(norm))
+                    : static_cast<float>(iterations);
+            }
+        }
+    }
+}
+
+// =======================================================================================
+// ATLAS HIMPUNAN JULIA (BANYAK KONSTANTA c DALAM SATU PELUNCURAN)
+// =======================================================================================
+
+void generate_julia_atlas_parallel(
+    std::vector<int>& iterations_out, int thumb_w, int thumb_h,
+    const std::vector<std::complex<float>>& constants,
+    float min_re, float max_re, float min_im, float max_im, int max_iterations)
+{
+    PROFILE_SCOPE("atlas_openmp");
+    const int count = static_cast<int>(constants.size());
+    float re_range = max_re - min_re;
+    float im_range = max_im - min_im;
+
+    #pragma omp parallel for collapse(2) schedule(dynamic)
+    for (int k = 0; k < count; ++k) {
+        for (int py = 0; py < thumb_h; ++py) {
+            std::complex<float> c = constants[k];
+            int* row = &iterations_out[(static_cast<size_t>(k) * thumb_h + py) * thumb_w];
+            for (int px = 0; px < thumb_w; ++px) {
+                std::complex<float> z(min_re + static_cast<float>(px) / (thumb_w - 1) * re_range,
+                                      min_im + static_cast<float>(py) / (thumb_h - 1) * im_range);
+                row[px] = escape_iterations(z, c, max_iterations);
+            }
+        }
+    }
+}
+
+#ifdef ENABLE_OPENCL
+void generate_julia_atlas_gpu(
+    OpenCLContext& ctx, std::vector<int>& iterations_out, int thumb_w, int thumb_h,
+    const std::vector<std::complex<float>>& constants,
+    float min_re, float max_re, float min_im, float max_im, int max_iterations)
+{
+    PROFILE_SCOPE("atlas_opencl");
+    const size_t count = constants.size();
+    const size_t total = count * thumb_w * thumb_h;
+
+    // std::complex<float> tersusun (re, im) sehingga bisa langsung dipakai sebagai float2
+    cl::Buffer constants_buffer(ctx.context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                                sizeof(std::complex<float>) * count, const_cast<std::complex<float>*>(constants.data()));
+    cl::Buffer output_buffer(ctx.context, CL_MEM_WRITE_ONLY, sizeof(int) * total);
+
+    cl::Kernel& kernel = ctx.atlas_kernel;
+    kernel.setArg(0, output_buffer); kernel.setArg(1, constants_buffer);
+    kernel.setArg(2, thumb_w); kernel.setArg(3, thumb_h);
+    kernel.setArg(4, min_re); kernel.setArg(5, max_re); kernel.setArg(6, min_im); kernel.setArg(7, max_im);
+    kernel.setArg(8, max_iterations);
+
+    ctx.queue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(thumb_w, thumb_h, count), cl::NullRange);
+    ctx.queue.enqueueReadBuffer(output_buffer, CL_TRUE, 0, sizeof(int) * total, iterations_out.data());
+}
+#endif
+
+// =======================================================================================
+// BUDDHABROT / ANTI-BUDDHABROT (KEPADATAN ORBIT)
+// =======================================================================================
+// Setiap thread menulis ke histogram privat miliknya (tanpa atomic/kontensi), lalu semua
+// histogram digabung paralel per potongan piksel.
+
+// Tes tertutup untuk kardioid utama dan bulb periode-2: c di dalamnya pasti tidak escape.
+static inline bool in_main_cardioid_or_bulb(float cr, float ci) {
+    float x = cr - 0.25f;
+    float q = x * x + ci * ci;
+    if (q * (q + x) <= 0.25f * ci * ci) return true;
+    float y = cr + 1.0f;
+    return y * y + ci * ci <= 0.0625f;
+}
+
+// splitmix64: generator per-thread yang murah, cukup untuk sampling Monte Carlo
+static inline uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline float uniform01(uint64_t& state) {
+    return static_cast<float>(splitmix64(state) >> 40) * (1.0f / 16777216.0f);
+}
+
+void generate_buddhabrot(
+    std::vector<uint32_t>& histogram, int width, int height,
+    float min_re, float max_re, float min_im, float max_im,
+    long long samples, bool anti, uint64_t seed, BuddhabrotStats& stats)
+{
+    PROFILE_SCOPE("buddhabrot");
+    const size_t n_pixels = static_cast<size_t>(width) * height;
+    const float scale_x = width / (max_re - min_re);
+    const float scale_y = height / (max_im - min_im);
+    // Area sampling = seluruh lingkaran escape |c| <= 2 agar latar dari orbit pendek merata
+    const float sample_min_re = -2.0f, sample_re_range = 4.0f, sample_min_im = -2.0f, sample_im_range = 4.0f;
+
+    const int n_threads = omp_get_max_threads();
+    std::vector<std::vector<uint32_t>> private_hist(n_threads);
+    long long total_rejected = 0, total_accepted = 0, total_points = 0;
+
+    #pragma omp parallel num_threads(n_threads) reduction(+:total_rejected, total_accepted, total_points)
+    {
+        const int tid = omp_get_thread_num();
+        std::vector<uint32_t>& hist = private_hist[tid];
+        hist.assign(n_pixels, 0); // first-touch oleh thread pemilik
+        uint64_t rng = seed ^ (0xD1B54A32D192ED03ULL * (tid + 1));
+
+        #pragma omp for schedule(dynamic, 4096)
+        for (long long s = 0; s < samples; ++s) {
+            float cr = sample_min_re + uniform01(rng) * sample_re_range;
+            float ci = sample_min_im + uniform01(rng) * sample_im_range;
+
+            bool known_interior = in_main_cardioid_or_bulb(cr, ci);
+            if (known_interior && !anti) { total_rejected++; continue; }
+
+            // Pass 1: tentukan apakah orbit escape (tidak perlu jika sudah pasti interior)
+            bool escaped = !known_interior &&
+                           escape_iterations<float>({0.0f, 0.0f}, {cr, ci}, MAX_ITERATIONS) < MAX_ITERATIONS;
+            if (escaped == anti) continue; // Buddhabrot: hanya orbit escape; anti: hanya orbit terbatas
+
+            // Pass 2: lacak ulang dan akumulasi kunjungan ke histogram privat
+            total_accepted++;
+            float zr = 0.0f, zi = 0.0f;
+            for (int i = 0; i < MAX_ITERATIONS; ++i) {
+                float zr2 = zr * zr, zi2 = zi * zi;
+                if (zr2 + zi2 > 4.0f) break;
+                zi = 2.0f * zr * zi + ci;
+                zr = zr2 - zi2 + cr;
+                int px = static_cast<int>((zr - min_re) * scale_x);
+                int py = static_cast<int>((zi - min_im) * scale_y);
+                if (px >= 0 && px < width && py >= 0 && py < height) {
+                    hist[static_cast<size_t>(py) * width + px]++;
+                    total_points++;
+                }
+            }
+        }
+
+        // Penggabungan: setiap thread menjumlahkan potongan pikselnya dari semua histogram privat
+        #pragma omp for schedule(static)
+        for (long long i = 0; i < static_cast<long long>(n_pixels); ++i) {
+            uint32_t sum = 0;
+            for (int t = 0; t < n_threads; ++t) sum += private_hist[t][i];
+            histogram[i] = sum;
+        }
+    }
+
+    stats.samples = samples;
+    stats.rejected = total_rejected;
+    stats.accepted_orbits = total_accepted;
+    stats.orbit_points = total_points;
+}
+
+// =======================================================================================
+// RENDERER
+// =======================================================================================
+
+const char* backend_name(Backend backend) {
+    switch (backend) {
+        case Backend::Serial: return "serial";
+        case Backend::OpenMP: return "openmp";
+        case Backend::OpenCL: return "opencl";
+    }
+    return "unknown";
+}
+
+bool parse_backend(const std::string& name, Backend& backend) {
+    if (name == "serial") backend = Backend::Serial;
+    else if (name == "openmp") backend = Backend::OpenMP;
+    else if (name == "opencl") backend = Backend::OpenCL;
+    else return false;
+    return true;
+}
+
+class SerialBackend : public RenderBackend {
+public:
+    const char* name() const override { return "serial"; }
+    void render(const RenderRequest& r, uint8_t* out, size_t stride) override {
+        generate_fractal_serial(out, stride, r.width, r.height, r.min_re, r.max_re, r.min_im, r.max_im,
+                                r.is_julia, r.julia_c, r.max_iterations, r.iterations_out);
+    }
+};
+
+class OpenMPBackend : public RenderBackend {
+public:
+    const char* name() const override { return "openmp"; }
+    void render(const RenderRequest& r, uint8_t* out, size_t stride) override {
+        generate_fractal_parallel(out, stride, r.width, r.height, r.min_re, r.max_re, r.min_im, r.max_im,
+                                  r.is_julia, r.julia_c, r.max_iterations, r.iterations_out);
+    }
+};
+
+#ifdef ENABLE_OPENCL
+// Konteks dibuat saat render pertama lalu disimpan selama backend hidup
+class OpenCLBackend : public RenderBackend {
+public:
+    const char* name() const override { return "opencl"; }
+    void render(const RenderRequest& r, uint8_t* out, size_t stride) override {
+        if (!ready) {
+            init_opencl_context(ctx);
+            ready = true;
+        }
+        generate_fractal_gpu(ctx, out, stride, r.width, r.height, r.min_re, r.max_re, r.min_im, r.max_im,
+                             r.is_julia, r.julia_c, r.max_iterations, nullptr, r.iterations_out);
+    }
+private:
+    OpenCLContext ctx;
+    bool ready = false;
+};
+#endif
+
+std::unique_ptr<RenderBackend> make_default_backend(Backend kind) {
+    switch (kind) {
+        case Backend::Serial: return std::unique_ptr<RenderBackend>(new SerialBackend());
+        case Backend::OpenMP: return std::unique_ptr<RenderBackend>(new OpenMPBackend());
+        case Backend::OpenCL:
+            #ifdef ENABLE_OPENCL
+            return std::unique_ptr<RenderBackend>(new OpenCLBackend());
+            #else
+            return nullptr;
+            #endif
+    }
+    return nullptr;
+}
+
+void generate_fractal_batch_parallel(
+    const std::vector<RenderRequest>& requests, const std::vector<uint8_t*>& outputs,
+    const std::vector<size_t>& strides)
+{
+    PROFILE_SCOPE("compute_openmp_batch");
+    std::vector<std::pair<int, int>> rows; // (indeks request, baris)
+    for (size_t r = 0; r < requests.size(); ++r)
+        for (int py = 0; py < requests[r].height; ++py) rows.push_back({static_cast<int>(r), py});
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const RenderRequest& req = requests[rows[i].first];
+        const int py = rows[i].second;
+        const float re_range = req.max_re - req.min_re;
+        const float cy = req.min_im + static_cast<float>(py) / (req.height - 1) * (req.max_im - req.min_im);
+        uint8_t* out = outputs[rows[i].first] + py * strides[rows[i].first];
+        for (int px = 0; px < req.width; ++px) {
+            float cx = req.min_re + static_cast<float>(px) / (req.width - 1) * re_range;
+            int iterations = point_iterations(cx, cy, req.is_julia, req.julia_c, req.max_iterations);
+            if (req.iterations_out) req.iterations_out[static_cast<size_t>(py) * req.width + px] = iterations;
+            Color color = map_iteration_to_color(iterations, req.max_iterations);
+            out[px * 3] = color.r; out[px * 3 + 1] = color.g; out[px * 3 + 2] = color.b;
+        }
+    }
+}
+
+Renderer::Renderer() {}
+
+Renderer::~Renderer() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        stopping = true;
+    }
+    queue_cv.notify_all();
+    if (worker.joinable()) worker.join();
+}
+
+void Renderer::set_backend(Backend kind, std::unique_ptr<RenderBackend> backend) {
+    std::lock_guard<std::mutex> lock(render_mutex);
+    backends[kind] = std::move(backend);
+}
+
+RenderBackend* Renderer::get_backend(Backend kind) {
+    auto it = backends.find(kind);
+    if (it == backends.end()) it = backends.emplace(kind, make_default_backend(kind)).first;
+    return it->second.get();
+}
+
+RenderResult Renderer::render(const RenderRequest& request, uint8_t* out, size_t stride) {
+    RenderResult result;
+    result.backend = request.backend;
+    if (request.width < 2 || request.height < 2 || request.max_iterations < 1) {
+        result.error = "Invalid render request.";
+        return result;
+    }
+    if (!out || stride < static_cast<size_t>(request.width) * 3) {
+        result.error = "Output buffer is null or stride is too small.";
+        return result;
+    }
+
+    std::lock_guard<std::mutex> lock(render_mutex);
+    RenderBackend* backend = get_backend(request.backend);
+    if (!backend) {
+        result.error = std::string("Backend not available: ") + backend_name(request.backend);
+        return result;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    try {
+        backend->render(request, out, stride);
+        result.ok = true;
+    #ifdef ENABLE_OPENCL
+    } catch (const cl::Error& e) {
+        result.error = std::string("OpenCL Error: ") + e.what() + " (" + std::to_string(e.err()) + ")";
+    #endif
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+std::vector<RenderResult> Renderer::render_batch(const std::vector<RenderRequest>& requests,
+                                                 const std::vector<uint8_t*>& outputs,
+                                                 const std::vector<size_t>& strides)
+{
+    std::vector<RenderResult> results(requests.size());
+    std::vector<RenderRequest> batch;
+    std::vector<uint8_t*> batch_outputs;
+    std::vector<size_t> batch_strides, batch_index;
+    for (size_t i = 0; i < requests.size(); ++i) {
+        const RenderRequest& req = requests[i];
+        bool valid = req.width >= 2 && req.height >= 2 && req.max_iterations >= 1 &&
+                     outputs[i] && strides[i] >= static_cast<size_t>(req.width) * 3;
+        if (valid && req.backend == Backend::OpenMP) {
+            batch.push_back(req); batch_outputs.push_back(outputs[i]);
+            batch_strides.push_back(strides[i]); batch_index.push_back(i);
+        } else {
+            results[i] = render(req, outputs[i], strides[i]);
+        }
+    }
+    if (!batch.empty()) {
+        std::lock_guard<std::mutex> lock(render_mutex);
+        auto start = std::chrono::steady_clock::now();
+        generate_fractal_batch_parallel(batch, batch_outputs, batch_strides);
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        for (size_t i : batch_index) {
+            results[i].ok = true;
+            results[i].backend = Backend::OpenMP;
+            results[i].elapsed_ms = elapsed;
+        }
+    }
+    return results;
+}
+
+std::future<RenderResult> Renderer::submit(const RenderRequest& request, uint8_t* out, size_t stride) {
+    Job job{request, out, stride, std::promise<RenderResult>(), nullptr};
+    std::future<RenderResult> future = job.promise.get_future();
+    enqueue(std::move(job));
+    return future;
+}
+
+void Renderer::submit(const RenderRequest& request, uint8_t* out, size_t stride, Callback on_done) {
+    enqueue(Job{request, out, stride, std::promise<RenderResult>(), std::move(on_done)});
+}
+
+void Renderer::enqueue(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        jobs.push_back(std::move(job));
+        if (!worker.joinable()) worker = std::thread(&Renderer::worker_loop, this);
+    }
+    queue_cv.notify_one();
+}
+
+void Renderer::worker_loop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            queue_cv.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (jobs.empty()) return; // stopping dan antrean sudah habis
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        RenderResult result = render(job.request, job.out, job.stride);
+        if (job.callback) job.callback(result);
+        else job.promise.set_value(result);
+    }
+}
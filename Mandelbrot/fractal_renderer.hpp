@@ -0,0 +1,315 @@
+/**
+ * fractal_renderer.hpp
+ * Library rendering fraktal (Mandelbrot / Julia) yang bisa di-embed langsung di proses lain.
+ * - Generator tingkat rendah (Serial, OpenMP, OpenCL) yang menulis ke buffer milik pemanggil
+ * - Renderer: RenderRequest + backend yang bisa diganti + submit async (std::future / callback)
+ * - Kernel atlas Julia dan Buddhabrot
+ *
+ * Format output: RGB 8-bit, 3 byte per piksel, `stride` = jumlah byte per baris (>= width * 3).
+ */
+#pragma once
+
+#define ENABLE_OPENCL
+
+#include <complex>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef ENABLE_OPENCL
+#define CL_HPP_ENABLE_EXCEPTIONS
+#include <CL/opencl.hpp>
+#endif
+
+#include "fractal_profiler.hpp"
+
+const int MAX_ITERATIONS = 1000;
+
+struct Color { uint8_t r, g, b; };
+
+inline Color map_iteration_to_color(int iterations, int max_iterations = MAX_ITERATIONS) {
+    if (iterations == max_iterations) return {0, 0, 0};
+    float t = static_cast<float>(iterations) / max_iterations;
+    uint8_t r = static_cast<uint8_t>(9 * (1 - t) * t * t * t * 255);
+    uint8_t g = static_cast<uint8_t>(15 * (1 - t) * (1 - t) * t * t * 255);
+    uint8_t b = static_cast<uint8_t>(8.5 * (1 - t) * (1 - t) * (1 - t) * t * 255);
+    return {r, g, b};
+}
+
+// Kernel escape-time bersama untuk semua jalur CPU: z <- z^2 + c sampai |z|^2 > 4 atau
+// max_iterations. Dengan T = float, uji bailout dan urutan operasinya sama seperti kernel OpenCL,
+// sehingga view yang sama memberi jumlah iterasi yang sama di jalur mana pun. T = double dipakai
+// video exponential map, yang zoom-nya melewati resolusi float. final_norm (opsional) menerima
+// |z|^2 terakhir.
+template <typename T>
+inline int escape_iterations(std::complex<T> z, std::complex<T> c, int max_iterations, T* final_norm = nullptr) {
+    T z_re = z.real(), z_im = z.imag();
+    const T c_re = c.real(), c_im = c.imag();
+    int iterations = 0;
+    while (iterations < max_iterations) {
+        T zr2 = z_re * z_re, zi2 = z_im * z_im;
+        if (zr2 + zi2 > T(4)) break;
+        z_im = T(2) * z_re * z_im + c_im;
+        z_re = zr2 - zi2 + c_re;
+        iterations++;
+    }
+    if (final_norm) *final_norm = z_re * z_re + z_im * z_im;
+    return iterations;
+}
+
+// Piksel di titik (cx, cy): Mandelbrot (z0 = 0, c = titik) atau Julia (z0 = titik, c = julia_c)
+inline int point_iterations(float cx, float cy, bool is_julia, std::complex<float> julia_c, int max_iterations,
+                            float* final_norm = nullptr)
+{
+    return is_julia ? escape_iterations<float>({cx, cy}, julia_c, max_iterations, final_norm)
+                    : escape_iterations<float>({0.0f, 0.0f}, {cx, cy}, max_iterations, final_norm);
+}
+
+// =======================================================================================
+// GENERATOR TINGKAT RENDAH (SERIAL, PARALEL, GPU)
+// =======================================================================================
+
+// iterations (opsional): plane jumlah iterasi rapat (width elemen per baris) yang diisi bersama RGB
+void generate_fractal_serial(
+    uint8_t* pixels, size_t stride, int width, int height,
+    float min_re, float max_re, float min_im, float max_im,
+    bool is_julia = false, std::complex<float> julia_c = {0,0}, int max_iterations = MAX_ITERATIONS,
+    int32_t* iterations = nullptr);
+
+void generate_fractal_parallel(
+    uint8_t* pixels, size_t stride, int width, int height,
+    float min_re, float max_re, float min_im, float max_im,
+    bool is_julia = false, std::complex<float> julia_c = {0,0}, int max_iterations = MAX_ITERATIONS,
+    int32_t* iterations = nullptr);
+
+// Overload untuk buffer std::vector rapat (stride = width * 3)
+inline void generate_fractal_serial(
+    std::vector<uint8_t>& pixels, int width, int height,
+    float min_re, float max_re, float min_im, float max_im,
+    bool is_julia = false, std::complex<float> julia_c = {0,0})
+{
+    generate_fractal_serial(pixels.data(), static_cast<size_t>(width) * 3, width, height,
+                            min_re, max_re, min_im, max_im, is_julia, julia_c);
+}
+
+inline void generate_fractal_parallel(
+    std::vector<uint8_t>& pixels, int width, int height,
+    float min_re, float max_re, float min_im, float max_im,
+    bool is_julia = false, std::complex<float> julia_c = {0,0})
+{
+    generate_fractal_parallel(pixels.data(), static_cast<size_t>(width) * 3, width, height,
+                              min_re, max_re, min_im, max_im, is_julia, julia_c);
+}
+
+#ifdef ENABLE_OPENCL
+// Konteks OpenCL yang dibuat sekali (discovery platform + build program) lalu dipakai ulang
+// untuk setiap frame. Queue dibuat dengan profiling agar waktu kernel bisa diukur dari event.
+// Frame dibagi menjadi `bands` band: kernel berjalan di `queue`, map/readback di `transfer_queue`,
+// sehingga readback band N tumpang tindih dengan komputasi band N+1.
+struct OpenCLContext {
+    cl::Device device;
+    cl::Context context;
+    cl::CommandQueue queue;
+    cl::CommandQueue transfer_queue;
+    cl::Program program;
+    cl::Kernel kernel;
+    cl::Kernel atlas_kernel;
+    int bands = 8;
+    bool host_unified_memory = false; // device CPU/iGPU: buffer ALLOC_HOST_PTR di-map tanpa salinan
+
+    // Ring buffer band (CL_MEM_ALLOC_HOST_PTR), dialokasikan ulang hanya jika frame membesar
+    std::vector<cl::Buffer> band_buffers;
+    size_t band_buffer_bytes = 0;
+};
+
+// Rincian waktu satu render GPU (ms). kernel/readback diambil dari event profiling OpenCL
+// dan dijumlahkan untuk semua band; overlap = (kernel + readback + colorize) - waktu dinding.
+struct GpuTimings {
+    double kernel_ms = 0.0;
+    double readback_ms = 0.0;
+    double colorize_ms = 0.0;
+    double overlap_ms = 0.0;
+    int bands = 0;
+};
+
+double event_duration_ms(const cl::Event& event);
+
+// Melempar cl::Error / std::runtime_error jika tidak ada device atau build gagal.
+void init_opencl_context(OpenCLContext& ctx, const std::string& kernel_path = "mandelbrot_kernel.cl");
+
+// Render dengan konteks yang sudah ada. Melempar cl::Error jika gagal.
+void generate_fractal_gpu(
+    OpenCLContext& ctx, uint8_t* pixels, size_t stride, int width, int height,
+    float min_re, float max_re, float min_im, float max_im,
+    bool is_julia, std::complex<float> julia_c, int max_iterations, GpuTimings* timings = nullptr,
+    int32_t* iterations = nullptr);
+
+inline void generate_fractal_gpu(
+    OpenCLContext& ctx, std::vector<uint8_t>& pixels, int width, int height,
+    float min_re, float max_re, float min_im, float max_im,
+    bool is_julia, std::complex<float> julia_c, GpuTimings* timings = nullptr)
+{
+    generate_fractal_gpu(ctx, pixels.data(), static_cast<size_t>(width) * 3, width, height,
+                         min_re, max_re, min_im, max_im, is_julia, julia_c, MAX_ITERATIONS, timings);
+}
+
+// Versi tanpa konteks eksplisit: konteks dibuat sekali saat panggilan pertama lalu dipakai ulang.
+// Error dicetak ke stderr (tidak dilempar).
+void generate_fractal_gpu(
+    std::vector<uint8_t>& pixels, int width, int height,
+    float min_re, float max_re, float min_im, float max_im,
+    bool is_julia, std::complex<float> julia_c);
+#endif
+
+// =======================================================================================
+// DATA ITERASI MENTAH (TANPA WARNA)
+// =======================================================================================
+
+// Jumlah iterasi untuk region [x0, x0 + w) x [y0, y0 + h) dari frame frame_w x frame_h, dengan
+// pemetaan koordinat yang sama persis seperti render frame penuh. Berjalan serial di thread
+// pemanggil (pemanggil memparalelkan antar region). out_stride dalam elemen, bukan byte.
+void generate_iterations_region(
+    int32_t* out, size_t out_stride, int frame_w, int frame_h, int x0, int y0, int w, int h,
+    float min_re, float max_re, float min_im, float max_im,
+    bool is_julia, std::complex<float> julia_c, int max_iterations);
+
+// Field lengkap per piksel (OpenMP): jumlah iterasi, iterasi halus (n + 1 - log2(log2|z|), sama
+// dengan n untuk titik interior), dan |z|^2 terakhir. Setiap plane row-major, rapat (width elemen
+// per baris); pointer plane boleh null jika tidak dibutuhkan.
+void generate_iteration_field_parallel(
+    int32_t* iterations, float* smooth, float* final_norm, int width, int height,
+    float min_re, float max_re, float min_im, float max_im,
+    bool is_julia, std::complex<float> julia_c, int max_iterations);
+
+// =======================================================================================
+// ATLAS JULIA & BUDDHABROT
+// =======================================================================================
+
+// Semua thumbnail ditulis ke satu buffer iterasi kontigu dengan layout [k][y][x],
+// k = indeks konstanta. Bidang z yang dipetakan sama untuk setiap thumbnail.
+void generate_julia_atlas_parallel(
+    std::vector<int>& iterations_out, int thumb_w, int thumb_h,
+    const std::vector<std::complex<float>>& constants,
+    float min_re, float max_re, float min_im, float max_im, int max_iterations = MAX_ITERATIONS);
+
+#ifdef ENABLE_OPENCL
+void generate_julia_atlas_gpu(
+    OpenCLContext& ctx, std::vector<int>& iterations_out, int thumb_w, int thumb_h,
+    const std::vector<std::complex<float>>& constants,
+    float min_re, float max_re, float min_im, float max_im, int max_iterations = MAX_ITERATIONS);
+#endif
+
+struct BuddhabrotStats {
+    long long samples = 0;          // total c yang diambil
+    long long rejected = 0;         // ditolak tanpa iterasi (kardioid/bulb utama)
+    long long accepted_orbits = 0;  // orbit yang diakumulasi
+    long long orbit_points = 0;     // total kunjungan yang ditulis ke histogram
+};
+
+// Titik c diambil acak, orbitnya dilacak, dan setiap titik orbit yang jatuh di dalam view
+// ditambahkan ke histogram kepadatan (histogram privat per thread, digabung di akhir).
+void generate_buddhabrot(
+    std::vector<uint32_t>& histogram, int width, int height,
+    float min_re, float max_re, float min_im, float max_im,
+    long long samples, bool anti, uint64_t seed, BuddhabrotStats& stats);
+
+// =======================================================================================
+// RENDERER: API TINGKAT TINGGI DENGAN BACKEND YANG BISA DIGANTI DAN SUBMIT ASYNC
+// =======================================================================================
+
+enum class Backend { Serial, OpenMP, OpenCL };
+
+const char* backend_name(Backend backend);
+bool parse_backend(const std::string& name, Backend& backend); // "serial" | "openmp" | "opencl"
+
+struct RenderRequest {
+    int width = 0, height = 0;
+    float min_re = -2.0f, max_re = 1.0f, min_im = -1.2f, max_im = 1.2f;
+    bool is_julia = false;
+    std::complex<float> julia_c = {0, 0};
+    int max_iterations = MAX_ITERATIONS;
+    Backend backend = Backend::OpenMP;
+    // Opsional: plane iterasi rapat (width * height) milik pemanggil. Backend bawaan mengisinya
+    // bersama RGB sehingga pemanggil bisa memakai ulang sampel (lihat zoom_reuse.hpp).
+    int32_t* iterations_out = nullptr;
+};
+
+struct RenderResult {
+    bool ok = false;
+    std::string error;
+    Backend backend = Backend::OpenMP;
+    double elapsed_ms = 0.0;
+};
+
+// Antarmuka backend. Implementasi boleh melempar exception; Renderer mengubahnya menjadi RenderResult.
+// Jika request.iterations_out tidak null, implementasi wajib mengisinya.
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+    virtual const char* name() const = 0;
+    virtual void render(const RenderRequest& request, uint8_t* out, size_t stride) = 0;
+};
+
+std::unique_ptr<RenderBackend> make_default_backend(Backend kind);
+
+// Render banyak request kecil (misalnya tile) dalam satu region OpenMP: baris dari semua request
+// dibagi secara dinamis ke thread sehingga device tidak kekurangan kerja untuk frame kecil.
+void generate_fractal_batch_parallel(
+    const std::vector<RenderRequest>& requests, const std::vector<uint8_t*>& outputs,
+    const std::vector<size_t>& strides);
+
+// Renderer menyimpan backend (termasuk konteks OpenCL) sepanjang umurnya. render() berjalan di
+// thread pemanggil; submit() mengantrekan job ke satu worker thread dan mengembalikan future atau
+// memanggil callback setelah selesai. Buffer output tetap milik pemanggil dan harus hidup sampai
+// job selesai. Semua render diserialisasi karena setiap backend sudah memakai semua core/device.
+class Renderer {
+public:
+    using Callback = std::function<void(const RenderResult&)>;
+
+    Renderer();
+    ~Renderer();
+    Renderer(const Renderer&) = delete;
+    Renderer& operator=(const Renderer&) = delete;
+
+    // Ganti implementasi backend (misalnya backend khusus milik aplikasi).
+    void set_backend(Backend kind, std::unique_ptr<RenderBackend> backend);
+
+    RenderResult render(const RenderRequest& request, uint8_t* out, size_t stride);
+    // Request OpenMP digabung ke satu region paralel; backend lain dirender satu per satu.
+    std::vector<RenderResult> render_batch(const std::vector<RenderRequest>& requests,
+                                           const std::vector<uint8_t*>& outputs,
+                                           const std::vector<size_t>& strides);
+    std::future<RenderResult> submit(const RenderRequest& request, uint8_t* out, size_t stride);
+    void submit(const RenderRequest& request, uint8_t* out, size_t stride, Callback on_done);
+
+private:
+    struct Job {
+        RenderRequest request;
+        uint8_t* out;
+        size_t stride;
+        std::promise<RenderResult> promise;
+        Callback callback;
+    };
+
+    RenderBackend* get_backend(Backend kind);
+    void enqueue(Job job);
+    void worker_loop();
+
+    std::map<Backend, std::unique_ptr<RenderBackend>> backends;
+    std::mutex render_mutex;
+
+    std::deque<Job> jobs;
+    std::mutex queue_mutex;
+    std::condition_variable queue_cv;
+    bool stopping = false;
+    std::thread worker;
+};
@@ -0,0 +1,630 @@
+/**
+ * frame_stream.cpp
+ * Implementasi encoder/decoder delta tile, server streaming, client viewer, dan benchmark loopback.
+ * Protokol:
+ *   server -> viewer : HELLO (ukuran frame, ukuran tile)
+ *   viewer -> server : INPUT (nomor urut + InputEvent), kapan saja
+ *   server -> viewer : FRAME header + tile; tile_count = 0 berarti ack input tanpa perubahan frame
+ */
+#include "frame_stream.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+#include <poll.h>
+
+#include "net_util.hpp"
+#include "stb_image_write.h"
+
+const int32_t MSG_STREAM_HELLO = 0x31535246; // "FRS1"
+const int32_t MSG_INPUT = 1;
+const int32_t MSG_FRAME = 2;
+
+struct StreamHelloMsg {
+    int32_t type;
+    int32_t width, height, tile_size;
+};
+
+struct InputMsg {
+    int32_t type;
+    uint32_t seq;
+    int32_t kind, key, button, x, y, wheel;
+};
+
+struct FrameMsgHeader {
+    int32_t type;
+    uint32_t frame_id;
+    uint32_t input_seq;        // input terakhir yang sudah diterapkan ke frame ini
+    int32_t shift_x, shift_y;  // geser frame viewer sebelum tile diterapkan
+    uint32_t tile_count;
+    uint32_t payload_bytes;
+};
+
+struct TileMsgHeader {
+    uint16_t tx, ty;           // indeks tile
+    uint8_t encoding;          // TileEncoding
+    uint8_t reserved[3];
+    uint32_t bytes;
+};
+
+static double steady_ms() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// =======================================================================================
+// ENCODER / DECODER TILE
+// =======================================================================================
+
+void shift_frame(std::vector<uint8_t>& rgb, int width, int height, int dx, int dy) {
+    if (dx == 0 && dy == 0) return;
+    std::vector<uint8_t> shifted(rgb.size(), 0);
+    const int x0 = std::max(0, -dx), x1 = std::min(width, width - dx);
+    for (int y = std::max(0, -dy); y < std::min(height, height - dy) && x0 < x1; ++y) {
+        std::memcpy(&shifted[(static_cast<size_t>(y) * width + x0) * 3],
+                    &rgb[(static_cast<size_t>(y + dy) * width + x0 + dx) * 3], static_cast<size_t>(x1 - x0) * 3);
+    }
+    rgb.swap(shifted);
+}
+
+FrameEncoder::FrameEncoder(int w, int h, int tile) : width(w), height(h), tile_size(tile) { reset(); }
+
+void FrameEncoder::reset() {
+    reference.assign(static_cast<size_t>(width) * height * 3, 0); // viewer baru mulai dari frame hitam
+}
+
+static void append(std::vector<uint8_t>& out, const void* data, size_t bytes) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), p, p + bytes);
+}
+
+void FrameEncoder::encode(const uint8_t* rgb, int shift_x, int shift_y, uint32_t frame_id, uint32_t input_seq,
+                          std::vector<uint8_t>& out, StreamEncodeStats* stats)
+{
+    PROFILE_SCOPE("stream_encode");
+    shift_frame(reference, width, height, shift_x, shift_y);
+    out.assign(sizeof(FrameMsgHeader), 0);
+    StreamEncodeStats st;
+    std::vector<uint8_t> rle, sparse;
+    std::vector<uint16_t> changed;
+
+    const int tiles_x = (width + tile_size - 1) / tile_size, tiles_y = (height + tile_size - 1) / tile_size;
+    for (int ty = 0; ty < tiles_y; ++ty) {
+        for (int tx = 0; tx < tiles_x; ++tx) {
+            const int x0 = tx * tile_size, y0 = ty * tile_size;
+            const int tw = std::min(tile_size, width - x0), th = std::min(tile_size, height - y0);
+            changed.clear();
+            for (int y = 0; y < th; ++y) {
+                const size_t row = (static_cast<size_t>(y0 + y) * width + x0) * 3;
+                if (std::memcmp(rgb + row, &reference[row], static_cast<size_t>(tw) * 3) == 0) continue;
+                for (int x = 0; x < tw; ++x)
+                    if (std::memcmp(rgb + row + x * 3, &reference[row + x * 3], 3) != 0)
+                        changed.push_back(static_cast<uint16_t>(y * tw + x));
+            }
+            if (changed.empty()) { st.tiles_skipped++; continue; }
+
+            // Kandidat: sparse (2 byte indeks + RGB per piksel berubah), RLE (run <= 256 piksel), mentah
+            const size_t raw_bytes = static_cast<size_t>(tw) * th * 3;
+            const size_t sparse_bytes = changed.size() * 5;
+            rle.clear();
+            if (sparse_bytes > raw_bytes / 8) {
+                for (int y = 0; y < th; ++y) {
+                    const uint8_t* p = rgb + (static_cast<size_t>(y0 + y) * width + x0) * 3;
+                    for (int x = 0; x < tw;) {
+                        int run = 1;
+                        while (x + run < tw && run < 256 && std::memcmp(p + (x + run) * 3, p + x * 3, 3) == 0) ++run;
+                        rle.push_back(static_cast<uint8_t>(run - 1));
+                        rle.insert(rle.end(), p + x * 3, p + x * 3 + 3);
+                        x += run;
+                    }
+                    if (rle.size() >= raw_bytes) break;
+                }
+            }
+
+            TileMsgHeader tile = {static_cast<uint16_t>(tx), static_cast<uint16_t>(ty), TILE_RAW, {0, 0, 0}, 0};
+            if (sparse_bytes <= raw_bytes && (rle.empty() || sparse_bytes <= rle.size())) {
+                tile.encoding = TILE_SPARSE;
+                sparse.clear();
+                for (uint16_t idx : changed) {
+                    const uint8_t* p = rgb + (static_cast<size_t>(y0 + idx / tw) * width + x0 + idx % tw) * 3;
+                    sparse.push_back(static_cast<uint8_t>(idx & 0xff));
+                    sparse.push_back(static_cast<uint8_t>(idx >> 8));
+                    sparse.insert(sparse.end(), p, p + 3);
+                }
+                tile.bytes = static_cast<uint32_t>(sparse.size());
+                append(out, &tile, sizeof(tile));
+                append(out, sparse.data(), sparse.size());
+                st.tiles_sparse++;
+            } else if (!rle.empty() && rle.size() < raw_bytes) {
+                tile.encoding = TILE_RLE;
+                tile.bytes = static_cast<uint32_t>(rle.size());
+                append(out, &tile, sizeof(tile));
+                append(out, rle.data(), rle.size());
+                st.tiles_rle++;
+            } else {
+                tile.bytes = static_cast<uint32_t>(raw_bytes);
+                append(out, &tile, sizeof(tile));
+                for (int y = 0; y < th; ++y)
+                    append(out, rgb + (static_cast<size_t>(y0 + y) * width + x0) * 3, static_cast<size_t>(tw) * 3);
+                st.tiles_raw++;
+            }
+            st.tiles_sent++;
+        }
+    }
+
+    FrameMsgHeader hdr = {MSG_FRAME, frame_id, input_seq, shift_x, shift_y, st.tiles_sent,
+                          static_cast<uint32_t>(out.size() - sizeof(FrameMsgHeader))};
+    std::memcpy(out.data(), &hdr, sizeof(hdr));
+    std::memcpy(reference.data(), rgb, reference.size());
+    st.bytes = out.size();
+    if (stats) *stats = st;
+}
+
+void FrameEncoder::encode_full(const uint8_t* rgb, uint32_t frame_id, uint32_t input_seq,
+                               std::vector<uint8_t>& out, StreamEncodeStats* stats)
+{
+    PROFILE_SCOPE("stream_encode");
+    out.assign(sizeof(FrameMsgHeader), 0);
+    StreamEncodeStats st;
+    const int tiles_x = (width + tile_size - 1) / tile_size, tiles_y = (height + tile_size - 1) / tile_size;
+    for (int ty = 0; ty < tiles_y; ++ty) {
+        for (int tx = 0; tx < tiles_x; ++tx) {
+            const int x0 = tx * tile_size, y0 = ty * tile_size;
+            const int tw = std::min(tile_size, width - x0), th = std::min(tile_size, height - y0);
+            TileMsgHeader tile = {static_cast<uint16_t>(tx), static_cast<uint16_t>(ty), TILE_RAW, {0, 0, 0},
+                                  static_cast<uint32_t>(tw * th * 3)};
+            append(out, &tile, sizeof(tile));
+            for (int y = 0; y < th; ++y)
+                append(out, rgb + (static_cast<size_t>(y0 + y) * width + x0) * 3, static_cast<size_t>(tw) * 3);
+            st.tiles_raw++;
+            st.tiles_sent++;
+        }
+    }
+    FrameMsgHeader hdr = {MSG_FRAME, frame_id, input_seq, 0, 0, st.tiles_sent,
+                          static_cast<uint32_t>(out.size() - sizeof(FrameMsgHeader))};
+    std::memcpy(out.data(), &hdr, sizeof(hdr));
+    std::memcpy(reference.data(), rgb, reference.size());
+    st.bytes = out.size();
+    if (stats) *stats = st;
+}
+
+FrameDecoder::FrameDecoder(int w, int h, int tile)
+    : width(w), height(h), tile_size(tile), frame(static_cast<size_t>(w) * h * 3, 0) {}
+
+bool FrameDecoder::apply(const uint8_t* msg, size_t bytes) {
+    if (bytes < sizeof(FrameMsgHeader)) return false;
+    FrameMsgHeader hdr;
+    std::memcpy(&hdr, msg, sizeof(hdr));
+    if (hdr.type != MSG_FRAME || sizeof(hdr) + hdr.payload_bytes != bytes) return false;
+    shift_frame(frame, width, height, hdr.shift_x, hdr.shift_y);
+
+    size_t pos = sizeof(hdr);
+    for (uint32_t i = 0; i < hdr.tile_count; ++i) {
+        TileMsgHeader tile;
+        if (pos + sizeof(tile) > bytes) return false;
+        std::memcpy(&tile, msg + pos, sizeof(tile));
+        pos += sizeof(tile);
+        const int x0 = tile.tx * tile_size, y0 = tile.ty * tile_size;
+        if (x0 >= width || y0 >= height || pos + tile.bytes > bytes) return false;
+        const int tw = std::min(tile_size, width - x0), th = std::min(tile_size, height - y0);
+        const uint8_t* p = msg + pos;
+        auto pixel = [&](int idx) { return &frame[(static_cast<size_t>(y0 + idx / tw) * width + x0 + idx % tw) * 3]; };
+
+        if (tile.encoding == TILE_RAW) {
+            if (tile.bytes != static_cast<uint32_t>(tw * th * 3)) return false;
+            for (int y = 0; y < th; ++y)
+                std::memcpy(&frame[(static_cast<size_t>(y0 + y) * width + x0) * 3], p + static_cast<size_t>(y) * tw * 3,
+                            static_cast<size_t>(tw) * 3);
+        } else if (tile.encoding == TILE_RLE) {
+            int idx = 0;
+            for (uint32_t k = 0; k + 4 <= tile.bytes; k += 4) {
+                int run = p[k] + 1;
+                if (idx + run > tw * th) return false;
+                for (int r = 0; r < run; ++r, ++idx) std::memcpy(pixel(idx), p + k + 1, 3);
+            }
+        } else if (tile.encoding == TILE_SPARSE) {
+            for (uint32_t k = 0; k + 5 <= tile.bytes; k += 5) {
+                int idx = p[k] | (p[k + 1] << 8);
+                if (idx >= tw * th) return false;
+                std::memcpy(pixel(idx), p + k + 2, 3);
+            }
+        } else {
+            return false;
+        }
+        pos += tile.bytes;
+    }
+    return pos == bytes;
+}
+
+// =======================================================================================
+// CLIENT (VIEWER)
+// =======================================================================================
+
+StreamClient::~StreamClient() { close(); }
+
+bool StreamClient::connect(const std::string& host, int port) {
+    fd = tcp_connect(host, port);
+    if (fd < 0) return false;
+    StreamHelloMsg hello;
+    if (!recv_all(fd, &hello, sizeof(hello)) || hello.type != MSG_STREAM_HELLO || hello.width < 2 || hello.height < 2 ||
+        hello.tile_size < 8 || hello.tile_size > 255) {
+        close();
+        return false;
+    }
+    frame_w = hello.width; frame_h = hello.height;
+    decoder = FrameDecoder(frame_w, frame_h, hello.tile_size);
+    return true;
+}
+
+uint32_t StreamClient::send_input(const InputEvent& e) {
+    if (fd < 0) return 0;
+    InputMsg msg = {MSG_INPUT, next_seq, static_cast<int32_t>(e.kind), e.key, e.button, e.x, e.y, e.wheel};
+    if (!send_all(fd, &msg, sizeof(msg))) return 0;
+    in_flight.push_back({next_seq, steady_ms()});
+    return next_seq++;
+}
+
+int StreamClient::poll_frame(int timeout_ms) {
+    if (fd < 0) return -1;
+    pollfd p = {fd, POLLIN, 0};
+    int r = poll(&p, 1, timeout_ms);
+    if (r == 0) return 0;
+    if (r < 0) return -1;
+
+    FrameMsgHeader hdr;
+    if (!recv_all(fd, &hdr, sizeof(hdr)) || hdr.type != MSG_FRAME) return -1;
+    message.resize(sizeof(hdr) + hdr.payload_bytes);
+    std::memcpy(message.data(), &hdr, sizeof(hdr));
+    if (hdr.payload_bytes && !recv_all(fd, message.data() + sizeof(hdr), hdr.payload_bytes)) return -1;
+    if (!decoder.apply(message.data(), message.size())) {
+        std::cerr << "Error: Frame stream rusak (frame " << hdr.frame_id << ")\n";
+        return -1;
+    }
+
+    const double now = steady_ms();
+    last_ack = hdr.tile_count == 0 && hdr.shift_x == 0 && hdr.shift_y == 0;
+    stats.bytes += static_cast<long long>(message.size());
+    if (last_ack) stats.acks++;
+    else { stats.frames++; stats.frame_bytes.push_back(static_cast<double>(message.size())); }
+    // Semua input sampai input_seq sudah tercermin di frame ini
+    size_t done = 0;
+    while (done < in_flight.size() && in_flight[done].first <= hdr.input_seq) {
+        if (!last_ack) stats.latencies.push_back(now - in_flight[done].second);
+        ++done;
+    }
+    in_flight.erase(in_flight.begin(), in_flight.begin() + done);
+    last_acked = std::max(last_acked, hdr.input_seq);
+    return 1;
+}
+
+void StreamClient::close() {
+    close_socket(fd);
+    fd = -1;
+}
+
+// =======================================================================================
+// SERVER
+// =======================================================================================
+
+// Offset piksel bulat antara dua view berskala sama (pan); false jika bukan pan murni.
+static bool pixel_shift(const RenderRequest& a, const RenderRequest& b, int& dx, int& dy) {
+    if (a.width != b.width || a.height != b.height || a.is_julia != b.is_julia || a.julia_c != b.julia_c ||
+        a.max_iterations != b.max_iterations) return false;
+    const double ra = static_cast<double>(a.max_re) - a.min_re, rb = static_cast<double>(b.max_re) - b.min_re;
+    const double ia = static_cast<double>(a.max_im) - a.min_im, ib = static_cast<double>(b.max_im) - b.min_im;
+    if (std::abs(rb / ra - 1.0) > 1e-5 || std::abs(ib / ia - 1.0) > 1e-5) return false;
+    const double ox = (static_cast<double>(b.min_re) - a.min_re) / (ra / (a.width - 1));
+    const double oy = (static_cast<double>(b.min_im) - a.min_im) / (ia / (a.height - 1));
+    dx = static_cast<int>(std::lround(ox)); dy = static_cast<int>(std::lround(oy));
+    return std::abs(ox - dx) < 0.01 && std::abs(oy - dy) < 0.01 && std::abs(dx) < a.width && std::abs(dy) < a.height;
+}
+
+// Inset Julia ditempel ke frame (nearest neighbour + bingkai putih), seperti sprite di GUI
+static void composite_inset(std::vector<uint8_t>& rgb, int width, int height, const JuliaInset& inset) {
+    const int x0 = width - inset.display_w - 10, y0 = height - inset.display_h - 10;
+    for (int y = -1; y <= inset.display_h; ++y) {
+        for (int x = -1; x <= inset.display_w; ++x) {
+            int px = x0 + x, py = y0 + y;
+            if (px < 0 || py < 0 || px >= width || py >= height) continue;
+            uint8_t* out = &rgb[(static_cast<size_t>(py) * width + px) * 3];
+            if (x < 0 || y < 0 || x == inset.display_w || y == inset.display_h) { out[0] = out[1] = out[2] = 255; continue; }
+            int sx = std::min(inset.render_w - 1, x * inset.render_w / inset.display_w);
+            int sy = std::min(inset.render_h - 1, y * inset.render_h / inset.display_h);
+            std::memcpy(out, &inset.rgb[(static_cast<size_t>(sy) * inset.render_w + sx) * 3], 3);
+        }
+    }
+}
+
+struct StreamSessionStats {
+    long long frames = 0, acks = 0, inputs = 0, bytes = 0, raw_bytes = 0;
+    long long tiles_sent = 0, tiles_skipped = 0, shifted_frames = 0;
+    double render_ms = 0.0, encode_ms = 0.0;
+};
+
+static StreamSessionStats serve_stream_client(int fd, const StreamServerConfig& cfg, Renderer& renderer,
+                                              BackendSelector& selector)
+{
+    StreamSessionStats ss;
+    const int w = cfg.width, h = cfg.height;
+    StreamHelloMsg hello = {MSG_STREAM_HELLO, w, h, cfg.tile_size};
+    if (!send_all(fd, &hello, sizeof(hello))) return ss;
+
+    ViewState state(w, h);
+    FrameEncoder encoder(w, h, cfg.tile_size);
+    IterationCache cache;
+    JuliaInset inset(w, h);
+    Backend backend = cfg.backend;
+    std::vector<uint8_t> base(static_cast<size_t>(w) * h * 3), rgba(static_cast<size_t>(w) * h * 4), frame, out;
+    RenderRequest sent_view;
+    bool have_sent = false;
+    uint32_t applied_seq = 0, acked_seq = 0, frame_id = 0;
+    std::vector<uint8_t> inbuf;
+    const double period_ms = 1000.0 / std::max(1.0, cfg.refresh_hz);
+    double next_frame_ms = 0.0;
+
+    bool connected = true;
+    while (connected) {
+        auto frame_due = [&] { return state.needs_redraw || (state.split_view && state.inset_dirty); };
+        int timeout = frame_due() ? std::max(0, static_cast<int>(std::ceil(next_frame_ms - steady_ms())))
+                                  : static_cast<int>(period_ms);
+        pollfd p = {fd, POLLIN, 0};
+        if (poll(&p, 1, timeout) > 0) {
+            uint8_t buf[16384];
+            long n = recv_some(fd, buf, sizeof(buf));
+            if (n <= 0) break;
+            inbuf.insert(inbuf.end(), buf, buf + n);
+            size_t pos = 0;
+            for (; pos + sizeof(InputMsg) <= inbuf.size() && connected; pos += sizeof(InputMsg)) {
+                InputMsg msg;
+                std::memcpy(&msg, &inbuf[pos], sizeof(msg));
+                if (msg.type != MSG_INPUT || msg.kind < 0 || msg.kind > static_cast<int>(InputKind::Close)) { connected = false; break; }
+                InputEvent e;
+                e.kind = static_cast<InputKind>(msg.kind);
+                e.key = static_cast<char>(msg.key); e.button = static_cast<char>(msg.button);
+                e.x = msg.x; e.y = msg.y; e.wheel = msg.wheel;
+                InputEffects fx = apply_input(state, e);
+                applied_seq = msg.seq;
+                ss.inputs++;
+                if (fx.close_requested) connected = false;
+                if (fx.save_requested && !frame.empty()) {
+                    std::string path = "fractal_stream_" + std::to_string(std::time(nullptr)) + ".png";
+                    if (stbi_write_png(path.c_str(), w, h, 3, frame.data(), w * 3)) std::cout << "Image saved to " << path << "\n";
+                }
+            }
+            inbuf.erase(inbuf.begin(), inbuf.begin() + std::min(pos, inbuf.size()));
+            if (!connected) break;
+        }
+        if (steady_ms() < next_frame_ms) continue;
+
+        if (frame_due()) {
+            auto t0 = std::chrono::steady_clock::now();
+            if (state.needs_redraw) {
+                if (state.grid_step) {
+                    render_view_reuse(cache, state, base, rgba);
+                } else {
+                    if (cfg.auto_backend) render_view_auto(renderer, selector, state, base, rgba, nullptr, &cache);
+                    else render_view(renderer, backend, state, base, rgba, &cache);
+                }
+                state.needs_redraw = false;
+                state.grid_step = false;
+            }
+            if (state.split_view && state.inset_dirty) {
+                render_julia_inset(inset, state);
+                state.inset_dirty = false;
+            }
+            frame = base;
+            if (state.split_view) composite_inset(frame, w, h, inset);
+            auto t1 = std::chrono::steady_clock::now();
+
+            // Pan bulat: viewer menggeser frame-nya; hanya strip baru + piksel yang berbeda dikirim
+            RenderRequest view = make_view_request(state, backend);
+            int dx = 0, dy = 0;
+            if (cfg.delta && (!have_sent || !pixel_shift(sent_view, view, dx, dy))) dx = dy = 0;
+            StreamEncodeStats es;
+            if (cfg.delta) encoder.encode(frame.data(), dx, dy, ++frame_id, applied_seq, out, &es);
+            else encoder.encode_full(frame.data(), ++frame_id, applied_seq, out, &es);
+            auto t2 = std::chrono::steady_clock::now();
+            if (!send_all(fd, out.data(), out.size())) break;
+
+            sent_view = view; have_sent = true; acked_seq = applied_seq;
+            next_frame_ms = steady_ms() + period_ms;
+            ss.frames++;
+            ss.bytes += static_cast<long long>(out.size());
+            ss.raw_bytes += static_cast<long long>(w) * h * 3;
+            ss.tiles_sent += es.tiles_sent; ss.tiles_skipped += es.tiles_skipped;
+            ss.shifted_frames += (dx != 0 || dy != 0);
+            ss.render_ms += std::chrono::duration<double, std::milli>(t1 - t0).count();
+            ss.encode_ms += std::chrono::duration<double, std::milli>(t2 - t1).count();
+        } else if (applied_seq != acked_seq) {
+            // Input tanpa perubahan frame tetap di-ack agar viewer bisa mengukur latensi
+            FrameMsgHeader ack = {MSG_FRAME, frame_id, applied_seq, 0, 0, 0, 0};
+            if (!send_all(fd, &ack, sizeof(ack))) break;
+            acked_seq = applied_seq;
+            ss.acks++;
+            ss.bytes += sizeof(ack);
+        }
+    }
+    return ss;
+}
+
+void run_stream_server(const StreamServerConfig& cfg) {
+    int listen_fd = tcp_listen(cfg.port, 4);
+    if (listen_fd < 0) {
+        std::cerr << "Error: Gagal listen di port " << cfg.port << "\n";
+        return;
+    }
+    Renderer renderer;
+    BackendSelector selector;
+    if (cfg.auto_backend) selector.load_or_calibrate(renderer);
+    std::cout << "Stream server di port " << cfg.port << " (" << cfg.width << "x" << cfg.height << ", tile "
+              << cfg.tile_size << ", backend " << (cfg.auto_backend ? "auto" : backend_name(cfg.backend))
+              << (cfg.delta ? "" : ", tanpa delta") << ")" << std::endl;
+
+    while (true) {
+        int fd = tcp_accept(listen_fd);
+        if (fd < 0) break;
+        std::cout << "Viewer terhubung" << std::endl;
+        StreamSessionStats ss = serve_stream_client(fd, cfg, renderer, selector);
+        close_socket(fd);
+        std::cout << std::fixed << std::setprecision(2) << "Viewer terputus: " << ss.inputs << " input, " << ss.frames
+                  << " frame (" << ss.shifted_frames << " dengan shift), " << ss.acks << " ack, "
+                  << ss.bytes / 1024.0 << " KiB dikirim (mentah " << ss.raw_bytes / 1024.0 << " KiB), tile dikirim "
+                  << ss.tiles_sent << " / dilewati " << ss.tiles_skipped << ", render rata-rata "
+                  << (ss.frames ? ss.render_ms / ss.frames : 0.0) << " ms, encode rata-rata "
+                  << (ss.frames ? ss.encode_ms / ss.frames : 0.0) << " ms" << std::endl;
+        if (cfg.once) break;
+    }
+    if (cfg.auto_backend && !selector.save()) std::cerr << "Error: Gagal menulis profil backend " << selector.path() << "\n";
+    close_socket(listen_fd);
+}
+
+// =======================================================================================
+// BENCHMARK LOOPBACK
+// =======================================================================================
+
+// Skrip input sintetis per kategori; koordinat relatif terhadap ukuran frame
+static void synthetic_stream_script(int w, int h, std::vector<std::pair<InputEvent, std::string>>& script) {
+    auto ev = [&](InputKind kind, int x, int y, const std::string& cat, char key = 0, char button = 0, int wheel = 0) {
+        InputEvent e;
+        e.kind = kind; e.x = x; e.y = y; e.key = key; e.button = button; e.wheel = wheel;
+        script.push_back({e, cat});
+    };
+    const int cx = w / 2, cy = h / 2;
+    ev(InputKind::MouseDown, cx, cy, "pan", 0, 'R');
+    for (int i = 1; i <= 20; ++i) ev(InputKind::MouseMove, cx + i * 6, cy + i * 3, "pan");
+    ev(InputKind::MouseUp, cx + 120, cy + 60, "pan", 0, 'R');
+    for (int i = 0; i < 3; ++i) ev(InputKind::Wheel, cx + 20 * i, cy - 10 * i, "zoom_roda", 0, 0, 1);
+    ev(InputKind::Wheel, cx, cy, "zoom_roda", 0, 0, -1);
+    ev(InputKind::MouseDown, w / 4, h / 4, "zoom_kotak", 0, 'L');
+    ev(InputKind::MouseUp, w * 3 / 4, h * 3 / 4, "zoom_kotak", 0, 'L');
+    ev(InputKind::Key, 0, 0, "reset", 'R');
+    ev(InputKind::Key, 0, 0, "julia", 'J');
+    for (int i = 1; i <= 10; ++i) ev(InputKind::MouseMove, w / 3 + i * 5, h / 3 + i * 2, "julia");
+    ev(InputKind::Key, 0, 0, "julia", 'J');
+    ev(InputKind::Key, 0, 0, "inset", 'V');
+    for (int i = 1; i <= 20; ++i) ev(InputKind::MouseMove, w / 4 + i * 8, h / 2 - i * 2, "inset");
+    ev(InputKind::Key, 0, 0, "inset_commit", 'L');
+}
+
+static uint64_t fnv1a(const std::vector<uint8_t>& data) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (uint8_t b : data) { hash ^= b; hash *= 1099511628211ULL; }
+    return hash;
+}
+
+void run_stream_bench(const StreamBenchConfig& cfg) {
+    std::vector<std::pair<InputEvent, std::string>> script;
+    int w = cfg.width, h = cfg.height;
+    if (!cfg.events_path.empty()) {
+        std::vector<InputEvent> events;
+        if (!load_input_recording(cfg.events_path, w, h, events)) {
+            std::cerr << "Error: Gagal membaca rekaman event " << cfg.events_path << "\n";
+            return;
+        }
+        const char* names[] = {"key", "down", "up", "move", "wheel", "close"};
+        for (const InputEvent& e : events)
+            if (e.kind != InputKind::Close) script.push_back({e, names[static_cast<int>(e.kind)]});
+    } else {
+        synthetic_stream_script(w, h, script);
+    }
+
+    StreamServerConfig sc;
+    sc.port = cfg.port; sc.width = w; sc.height = h;
+    sc.auto_backend = false; sc.backend = cfg.backend; sc.delta = cfg.delta; sc.once = true;
+    std::thread server([sc] { run_stream_server(sc); });
+
+    StreamClient client;
+    bool connected = false;
+    for (int attempt = 0; attempt < 100 && !connected; ++attempt) {
+        connected = client.connect("127.0.0.1", cfg.port);
+        if (!connected) std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    if (!connected || client.poll_frame(60000) != 1) {
+        std::cerr << "Error: Gagal terhubung ke stream server loopback\n";
+        client.close();
+        server.join();
+        return;
+    }
+    const double keyframe_bytes = client.stats.frame_bytes.empty() ? 0.0 : client.stats.frame_bytes.front();
+    std::cout << "Stream bench " << w << "x" << h << " (loopback, " << (cfg.delta ? "delta tile" : "frame penuh")
+              << ", backend " << backend_name(cfg.backend) << "): " << script.size() << " input, keyframe "
+              << keyframe_bytes / 1024.0 << " KiB\n";
+
+    // Closed loop: input berikutnya dikirim setelah frame yang memuat input sebelumnya diterima
+    struct Category { std::vector<double> bytes, latency; };
+    std::map<std::string, Category> categories;
+    std::vector<std::string> order;
+    for (const auto& item : script) {
+        long long bytes_before = client.stats.bytes;
+        size_t latencies_before = client.stats.latencies.size();
+        uint32_t seq = client.send_input(item.first);
+        int r = 1;
+        while (seq && client.acked_input() < seq && (r = client.poll_frame(60000)) == 1) {}
+        if (!seq || r != 1) { std::cerr << "Error: Koneksi stream terputus\n"; break; }
+        if (client.stats.latencies.size() == latencies_before) continue; // hanya ack
+        if (!categories.count(item.second)) order.push_back(item.second);
+        Category& c = categories[item.second];
+        c.bytes.push_back(static_cast<double>(client.stats.bytes - bytes_before));
+        c.latency.push_back(client.stats.latencies.back());
+    }
+    const uint64_t checksum = fnv1a(client.rgb());
+    InputEvent close_event;
+    close_event.kind = InputKind::Close;
+    client.send_input(close_event);
+    client.close();
+    server.join();
+
+    auto pct = [](std::vector<double> v, double p) {
+        if (v.empty()) return 0.0;
+        std::sort(v.begin(), v.end());
+        return v[std::min(v.size() - 1, static_cast<size_t>(std::ceil(p * v.size())) - 1)];
+    };
+    auto mean = [](const std::vector<double>& v) {
+        double s = 0.0;
+        for (double x : v) s += x;
+        return v.empty() ? 0.0 : s / v.size();
+    };
+    const double raw = static_cast<double>(w) * h * 3;
+    std::cout << std::fixed << std::setprecision(2) << std::left << std::setw(14) << "Kategori" << std::right
+              << std::setw(8) << "Frame" << std::setw(14) << "KiB/frame" << std::setw(12) << "% mentah"
+              << std::setw(14) << "Lat p50 ms" << std::setw(14) << "Lat p99 ms" << "\n";
+    for (const std::string& name : order) {
+        const Category& c = categories[name];
+        std::cout << std::left << std::setw(14) << name << std::right << std::setw(8) << c.bytes.size()
+                  << std::setw(14) << mean(c.bytes) / 1024.0 << std::setw(12) << 100.0 * mean(c.bytes) / raw
+                  << std::setw(14) << pct(c.latency, 0.5) << std::setw(14) << pct(c.latency, 0.99) << "\n";
+    }
+    const StreamClientStats& st = client.stats;
+    std::cout << "Total: " << st.frames << " frame + " << st.acks << " ack, " << st.bytes / 1024.0 << " KiB, rata-rata "
+              << mean(st.frame_bytes) / 1024.0 << " KiB/frame (mentah " << raw / 1024.0 << " KiB), latensi p50 "
+              << pct(st.latencies, 0.5) << " ms, p90 " << pct(st.latencies, 0.9) << " ms, p99 "
+              << pct(st.latencies, 0.99) << " ms\n"
+              << "Checksum frame akhir viewer: " << std::hex << checksum << std::dec << "\n";
+
+    if (!cfg.output_prefix.empty()) {
+        std::ofstream out(cfg.output_prefix + ".json");
+        if (!out) { std::cerr << "Error: Gagal menulis " << cfg.output_prefix << ".json\n"; return; }
+        out << std::fixed << std::setprecision(4) << "{\n  \"width\": " << w << ",\n  \"height\": " << h
+            << ",\n  \"delta\": " << (cfg.delta ? "true" : "false") << ",\n  \"backend\": \"" << backend_name(cfg.backend)
+            << "\",\n  \"frames\": " << st.frames << ",\n  \"acks\": " << st.acks << ",\n  \"total_bytes\": " << st.bytes
+            << ",\n  \"keyframe_bytes\": " << keyframe_bytes << ",\n  \"mean_frame_bytes\": " << mean(st.frame_bytes)
+            << ",\n  \"raw_frame_bytes\": " << raw << ",\n  \"latency_p50_ms\": " << pct(st.latencies, 0.5)
+            << ",\n  \"latency_p99_ms\": " << pct(st.latencies, 0.99) << ",\n  \"categories\": {";
+        for (size_t i = 0; i < order.size(); ++i) {
+            const Category& c = categories[order[i]];
+            out << (i ? "," : "") << "\n    \"" << order[i] << "\": {\"frames\": " << c.bytes.size() << ", \"mean_bytes\": "
+                << mean(c.bytes) << ", \"latency_p50_ms\": " << pct(c.latency, 0.5) << ", \"latency_p99_ms\": "
+                << pct(c.latency, 0.99) << "}";
+        }
+        out << "\n  }\n}\n";
+        std::cout << "Hasil: " << cfg.output_prefix << ".json\n";
+    }
+}
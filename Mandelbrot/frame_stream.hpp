@@ -0,0 +1,113 @@
+/**
+ * frame_stream.hpp
+ * Streaming explorer interaktif lewat TCP. Loop render (ViewState + apply_input + render yang
+ * sama dengan GUI) berjalan di mesin render tanpa window; viewer ringan hanya menampilkan frame
+ * dan mengirim event input balik. Frame dikirim sebagai delta per tile terhadap frame yang sudah
+ * dimiliki viewer:
+ *   - pan dengan offset piksel bulat dikirim sebagai shift (viewer menggeser buffernya sendiri)
+ *   - tile yang sama dengan prediksi (frame lama, setelah shift) tidak dikirim sama sekali
+ *   - tile yang berubah dikirim mentah, RLE, atau sparse (indeks + RGB piksel yang berbeda),
+ *     mana yang paling kecil
+ * Protokol biner memakai byte order host (seperti distributed_render): server dan viewer harus
+ * berarsitektur sama.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "fractal_renderer.hpp"
+#include "gui_replay.hpp"
+
+struct StreamServerConfig {
+    int port = 9100;
+    int width = 1280, height = 720;
+    int tile_size = 64;            // 8..255
+    bool auto_backend = true;      // false: `backend`
+    Backend backend = Backend::OpenMP;
+    bool delta = true;             // false: setiap frame dikirim penuh (pembanding)
+    double refresh_hz = 60.0;
+    bool once = false;             // keluar setelah viewer pertama terputus
+};
+
+struct StreamBenchConfig {
+    int width = 640, height = 360;
+    int port = 9101;
+    std::string events_path;       // kosong = skrip sintetis (pan, zoom roda, Julia, inset)
+    bool delta = true;
+    Backend backend = Backend::OpenMP;
+    std::string output_prefix;     // kosong = tanpa JSON
+};
+
+enum TileEncoding : uint8_t { TILE_RAW = 0, TILE_RLE = 1, TILE_SPARSE = 2 };
+
+struct StreamEncodeStats {
+    uint32_t tiles_sent = 0, tiles_skipped = 0;
+    uint32_t tiles_raw = 0, tiles_rle = 0, tiles_sparse = 0;
+    size_t bytes = 0;              // total pesan termasuk header
+};
+
+// new(x, y) = old(x + dx, y + dy); piksel di luar frame lama menjadi hitam.
+void shift_frame(std::vector<uint8_t>& rgb, int width, int height, int dx, int dy);
+
+// Encoder menyimpan salinan frame yang dimiliki viewer sebagai referensi delta.
+class FrameEncoder {
+public:
+    FrameEncoder(int width, int height, int tile_size);
+    void reset();  // viewer baru / paksa keyframe
+    void encode(const uint8_t* rgb, int shift_x, int shift_y, uint32_t frame_id, uint32_t input_seq,
+                std::vector<uint8_t>& out, StreamEncodeStats* stats = nullptr);
+    // Frame penuh tanpa delta: setiap tile dikirim mentah sehingga menimpa seluruh frame viewer.
+    void encode_full(const uint8_t* rgb, uint32_t frame_id, uint32_t input_seq,
+                     std::vector<uint8_t>& out, StreamEncodeStats* stats = nullptr);
+private:
+    int width, height, tile_size;
+    std::vector<uint8_t> reference;
+};
+
+// Menerapkan pesan frame (header + tile) ke buffer RGB milik viewer.
+class FrameDecoder {
+public:
+    FrameDecoder(int width, int height, int tile_size);
+    bool apply(const uint8_t* message, size_t bytes);
+    const std::vector<uint8_t>& rgb() const { return frame; }
+private:
+    int width, height, tile_size;
+    std::vector<uint8_t> frame;
+};
+
+struct StreamClientStats {
+    long long frames = 0, acks = 0;      // ack = balasan input tanpa perubahan frame
+    long long bytes = 0;
+    std::vector<double> frame_bytes;     // per frame dengan tile
+    std::vector<double> latencies;       // input dikirim -> frame yang memuatnya diterapkan (ms)
+};
+
+// Sisi viewer: koneksi, kirim input, terima + dekode frame. Dipakai viewer SFML dan benchmark.
+class StreamClient {
+public:
+    ~StreamClient();
+    bool connect(const std::string& host, int port);
+    int width() const { return frame_w; }
+    int height() const { return frame_h; }
+    uint32_t send_input(const InputEvent& event); // mengembalikan nomor urut input (0 = gagal)
+    // Menunggu sampai timeout_ms. 1 = frame (atau ack) diterapkan, 0 = belum ada, -1 = koneksi putus.
+    int poll_frame(int timeout_ms);
+    uint32_t acked_input() const { return last_acked; }
+    bool last_was_ack() const { return last_ack; }
+    const std::vector<uint8_t>& rgb() const { return decoder.rgb(); }
+    void close();
+    StreamClientStats stats;
+private:
+    int fd = -1;
+    int frame_w = 0, frame_h = 0;
+    FrameDecoder decoder{0, 0, 8};
+    uint32_t next_seq = 1, last_acked = 0;
+    bool last_ack = false;
+    std::vector<std::pair<uint32_t, double>> in_flight; // (seq, waktu kirim ms)
+    std::vector<uint8_t> message;
+};
+
+void run_stream_server(const StreamServerConfig& cfg);
+void run_stream_bench(const StreamBenchConfig& cfg);
@@ -0,0 +1,476 @@
+/**
+ * gui_replay.cpp
+ * Implementasi update view GUI, perekam event, dan replay headless untuk mengukur latensi.
+ */
+#include "gui_replay.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+// =======================================================================================
+// UPDATE VIEW DARI INPUT
+// =======================================================================================
+
+void ViewState::reset_view() {
+    min_re = -2.0f; max_re = 1.0f;
+    min_im = -1.2f; max_im = min_im + (max_re - min_re) * static_cast<float>(height) / width;
+    needs_redraw = true;
+}
+
+InputEffects apply_input(ViewState& s, const InputEvent& event) {
+    InputEffects fx;
+    const bool was_pending = s.needs_redraw;
+    s.needs_redraw = false;
+
+    switch (event.kind) {
+    case InputKind::Close:
+        fx.close_requested = true;
+        break;
+
+    case InputKind::Key:
+        if (event.key == 'J') {
+            s.is_julia = !s.is_julia; s.needs_redraw = true;
+            fx.mode_changed = true;
+            if (s.split_view) { s.split_view = false; fx.split_changed = true; }
+        } else if (event.key == 'V') {
+            s.split_view = !s.split_view;
+            fx.split_changed = true;
+            if (s.split_view) {
+                // Base selalu Mandelbrot; hanya dirender ulang jika sebelumnya Julia
+                if (s.is_julia) { s.is_julia = false; s.needs_redraw = true; fx.mode_changed = true; }
+                s.inset_dirty = true;
+            }
+        } else if (event.key == 'L' && s.split_view) {
+            // Commit: render Julia resolusi penuh untuk konstanta inset, terkunci
+            s.split_view = false; fx.split_changed = true;
+            s.is_julia = true; s.julia_c = s.inset_c; s.julia_locked = true;
+            s.min_re = -1.6f; s.max_re = 1.6f;
+            s.min_im = -0.5f * (s.max_re - s.min_re) * static_cast<float>(s.height) / s.width;
+            s.max_im = -s.min_im;
+            s.needs_redraw = true;
+            fx.mode_changed = true; fx.lock_changed = true;
+        } else if (event.key == 'R') {
+            s.reset_view();
+        } else if (event.key == 'S') {
+            fx.save_requested = true;
+        } else if (event.key == 'H') {
+            s.show_hud = !s.show_hud; s.needs_redraw = true;
+            fx.hud_toggled = true;
+        } else if (event.key == 'L' && s.is_julia) {
+            s.julia_locked = !s.julia_locked;
+            fx.lock_changed = true;
+        }
+        break;
+
+    case InputKind::MouseDown:
+        if (event.button == 'L') {
+            s.is_zooming = true;
+            s.zoom_start_x = static_cast<float>(event.x); s.zoom_start_y = static_cast<float>(event.y);
+        } else if (event.button == 'R') {
+            s.right_dragging = true;
+            s.last_mouse_x = event.x; s.last_mouse_y = event.y;
+        }
+        break;
+
+    case InputKind::MouseUp:
+        if (event.button == 'L' && s.is_zooming) {
+            s.is_zooming = false;
+            float end_x = static_cast<float>(event.x), end_y = static_cast<float>(event.y);
+            if (s.zoom_start_x != end_x && s.zoom_start_y != end_y) {
+                float re_range = s.max_re - s.min_re;
+                float new_min_re = s.min_re + (std::min(s.zoom_start_x, end_x) / s.width) * re_range;
+                float new_max_re = s.min_re + (std::max(s.zoom_start_x, end_x) / s.width) * re_range;
+                float new_min_im = s.min_im + (std::min(s.zoom_start_y, end_y) / s.height) * (s.max_im - s.min_im);
+                s.max_im = new_min_im + (new_max_re - new_min_re) * static_cast<float>(s.height) / s.width;
+                s.min_re = new_min_re; s.max_re = new_max_re; s.min_im = new_min_im;
+                s.needs_redraw = true;
+            }
+        } else if (event.button == 'R') {
+            s.right_dragging = false;
+        }
+        break;
+
+    case InputKind::Wheel:
+        if (event.wheel != 0) {
+            // Zoom 2^n di sekitar kursor, di-snap ke grid frame sekarang
+            snap_power_of_two_zoom(s.min_re, s.max_re, s.min_im, s.max_im, s.width, s.height,
+                                   event.x, event.y, event.wheel);
+            s.needs_redraw = true;
+        }
+        break;
+
+    case InputKind::MouseMove:
+        s.mouse_x = event.x; s.mouse_y = event.y;
+        // Pan (klik kanan)
+        if (s.right_dragging) {
+            // Jarak sampel = range / (n - 1), sehingga pan selalu bergeser sejumlah bulat piksel
+            float dx = -static_cast<float>(event.x - s.last_mouse_x) * (s.max_re - s.min_re) / (s.width - 1);
+            float dy = -static_cast<float>(event.y - s.last_mouse_y) * (s.max_im - s.min_im) / (s.height - 1);
+            s.min_re += dx; s.max_re += dx; s.min_im += dy; s.max_im += dy;
+            s.needs_redraw = true;
+            s.last_mouse_x = event.x; s.last_mouse_y = event.y;
+        }
+        // Split view: konstanta inset mengikuti mouse, base tidak dirender ulang
+        if (s.split_view) {
+            s.inset_c.real(s.min_re + (static_cast<float>(event.x) / s.width) * (s.max_re - s.min_re));
+            s.inset_c.imag(s.min_im + (static_cast<float>(event.y) / s.height) * (s.max_im - s.min_im));
+            s.inset_dirty = true;
+        }
+        // Konstanta Julia mengikuti mouse
+        if (s.is_julia && !s.julia_locked) {
+            s.julia_c.real(s.min_re + (static_cast<float>(event.x) / s.width) * (s.max_re - s.min_re));
+            s.julia_c.imag(s.min_im + (static_cast<float>(event.y) / s.height) * (s.max_im - s.min_im));
+            s.needs_redraw = true;
+        }
+        break;
+    }
+
+    fx.redraw_requested = s.needs_redraw;
+    if (s.split_view && s.needs_redraw) s.inset_dirty = true; // view berubah: c di bawah kursor ikut berubah
+    fx.inset_requested = s.split_view && s.inset_dirty && !fx.redraw_requested;
+    // Redraw lain yang digabung ke frame yang sama membatalkan jalur pakai-ulang
+    if (s.needs_redraw) s.grid_step = (event.kind == InputKind::Wheel) && (!was_pending || s.grid_step);
+    s.needs_redraw = s.needs_redraw || was_pending;
+    return fx;
+}
+
+static void rgb_to_rgba(const std::vector<uint8_t>& rgb, std::vector<uint8_t>& rgba, int pixels) {
+    PROFILE_SCOPE("rgb_to_rgba");
+    for (int i = 0; i < pixels; ++i) {
+        rgba[i*4 + 0] = rgb[i*3 + 0]; rgba[i*4 + 1] = rgb[i*3 + 1];
+        rgba[i*4 + 2] = rgb[i*3 + 2]; rgba[i*4 + 3] = 255;
+    }
+}
+
+RenderRequest make_view_request(const ViewState& s, Backend backend) {
+    RenderRequest request;
+    request.width = s.width; request.height = s.height;
+    request.min_re = s.min_re; request.max_re = s.max_re; request.min_im = s.min_im; request.max_im = s.max_im;
+    request.is_julia = s.is_julia; request.julia_c = s.julia_c;
+    request.backend = backend;
+    return request;
+}
+
+RenderResult render_view(Renderer& renderer, Backend& backend, const ViewState& s,
+                         std::vector<uint8_t>& rgb, std::vector<uint8_t>& rgba, IterationCache* cache)
+{
+    const int width = s.width, height = s.height;
+    RenderRequest request = make_view_request(s, backend);
+    if (cache) {
+        cache->iterations.resize(static_cast<size_t>(width) * height);
+        request.iterations_out = cache->iterations.data();
+    }
+    RenderResult result = renderer.render(request, rgb.data(), static_cast<size_t>(width) * 3);
+    if (!result.ok && backend == Backend::OpenCL) {
+        std::cerr << result.error << " -- beralih ke OpenMP\n";
+        backend = request.backend = Backend::OpenMP;
+        result = renderer.render(request, rgb.data(), static_cast<size_t>(width) * 3);
+    }
+    if (cache) {
+        request.iterations_out = nullptr;
+        cache->view = request;
+        cache->valid = result.ok;
+    }
+    rgb_to_rgba(rgb, rgba, width * height);
+    return result;
+}
+
+RenderResult render_view_auto(Renderer& renderer, BackendSelector& selector, const ViewState& s,
+                              std::vector<uint8_t>& rgb, std::vector<uint8_t>& rgba, BackendChoice* choice_out,
+                              IterationCache* cache)
+{
+    BackendChoice choice;
+    {
+        PROFILE_SCOPE("backend_probe");
+        choice = selector.choose(make_view_request(s, Backend::OpenMP));
+    }
+    Backend backend = choice.backend;
+    RenderResult result = render_view(renderer, backend, s, rgb, rgba, cache);
+    if (backend != choice.backend) selector.mark_unavailable(choice.backend);
+    selector.record(choice, result);
+    if (choice_out) *choice_out = choice;
+    return result;
+}
+
+ReuseStats render_view_reuse(IterationCache& cache, const ViewState& s,
+                             std::vector<uint8_t>& rgb, std::vector<uint8_t>& rgba)
+{
+    ReuseStats stats = render_with_reuse(cache, make_view_request(s, Backend::OpenMP), rgb.data(),
+                                         static_cast<size_t>(s.width) * 3);
+    rgb_to_rgba(rgb, rgba, s.width * s.height);
+    return stats;
+}
+
+JuliaInset::JuliaInset(int window_w, int window_h)
+    : display_w(std::max(16, window_w / 3)), display_h(std::max(16, window_h / 3)) {}
+
+void render_julia_inset(JuliaInset& inset, const ViewState& s) {
+    PROFILE_SCOPE("julia_inset");
+    inset.c = s.inset_c;
+    inset.render_w = std::max(2, inset.display_w / inset.scale);
+    inset.render_h = std::max(2, inset.display_h / inset.scale);
+    inset.rgb.resize(static_cast<size_t>(inset.render_w) * inset.render_h * 3);
+    inset.rgba.resize(static_cast<size_t>(inset.render_w) * inset.render_h * 4);
+
+    const float min_re = -1.6f, max_re = 1.6f;
+    const float half_im = 0.5f * (max_re - min_re) * static_cast<float>(inset.display_h) / inset.display_w;
+    auto start = std::chrono::steady_clock::now();
+    generate_fractal_parallel(inset.rgb.data(), static_cast<size_t>(inset.render_w) * 3, inset.render_w, inset.render_h,
+                              min_re, max_re, -half_im, half_im, true, inset.c, inset.max_iterations);
+    inset.last_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    rgb_to_rgba(inset.rgb, inset.rgba, inset.render_w * inset.render_h);
+
+    // Kontrol budget: turunkan iterasi dulu (murah secara visual), baru resolusi; naikkan
+    // resolusi hanya jika perkiraan 4x biayanya masih di bawah budget.
+    if (inset.last_ms > inset.budget_ms) {
+        if (inset.max_iterations > 96) inset.max_iterations = std::max(96, inset.max_iterations * 3 / 4);
+        else if (inset.scale < 8) inset.scale *= 2;
+    } else if (inset.last_ms * 4.0 < inset.budget_ms * 0.8 && inset.scale > 1) {
+        inset.scale /= 2;
+    } else if (inset.last_ms < inset.budget_ms * 0.5 && inset.max_iterations < MAX_ITERATIONS) {
+        inset.max_iterations = std::min(MAX_ITERATIONS, inset.max_iterations * 5 / 4);
+    }
+}
+
+// =======================================================================================
+// REKAM & MUAT FILE EVENT
+// =======================================================================================
+
+bool InputRecorder::open(const std::string& path, int width, int height) {
+    out.open(path);
+    if (!out) return false;
+    out << "# fractal_generator gui events v1\n" << "size " << width << " " << height << "\n";
+    out << std::fixed << std::setprecision(3);
+    return true;
+}
+
+void InputRecorder::record(const InputEvent& e) {
+    if (!out) return;
+    out << e.t_ms << ' ';
+    switch (e.kind) {
+        case InputKind::Key:       out << "key " << e.key; break;
+        case InputKind::MouseDown: out << "down " << e.button << ' ' << e.x << ' ' << e.y; break;
+        case InputKind::MouseUp:   out << "up " << e.button << ' ' << e.x << ' ' << e.y; break;
+        case InputKind::MouseMove: out << "move " << e.x << ' ' << e.y; break;
+        case InputKind::Wheel:     out << "wheel " << e.wheel << ' ' << e.x << ' ' << e.y; break;
+        case InputKind::Close:     out << "close"; break;
+    }
+    out << '\n';
+}
+
+bool load_input_recording(const std::string& path, int& width, int& height, std::vector<InputEvent>& events) {
+    std::ifstream in(path);
+    if (!in) return false;
+    width = height = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream ls(line);
+        if (line.compare(0, 5, "size ") == 0) {
+            std::string tag;
+            ls >> tag >> width >> height;
+            continue;
+        }
+        InputEvent e;
+        std::string kind;
+        if (!(ls >> e.t_ms >> kind)) continue;
+        if (kind == "key") { e.kind = InputKind::Key; ls >> e.key; }
+        else if (kind == "down") { e.kind = InputKind::MouseDown; ls >> e.button >> e.x >> e.y; }
+        else if (kind == "up") { e.kind = InputKind::MouseUp; ls >> e.button >> e.x >> e.y; }
+        else if (kind == "move") { e.kind = InputKind::MouseMove; ls >> e.x >> e.y; }
+        else if (kind == "wheel") { e.kind = InputKind::Wheel; ls >> e.wheel >> e.x >> e.y; }
+        else if (kind == "close") e.kind = InputKind::Close;
+        else continue;
+        events.push_back(e);
+    }
+    std::stable_sort(events.begin(), events.end(),
+                     [](const InputEvent& a, const InputEvent& b) { return a.t_ms < b.t_ms; });
+    return width >= 2 && height >= 2;
+}
+
+// =======================================================================================
+// REPLAY HEADLESS
+// =======================================================================================
+
+// Loop replay meniru loop GUI: ambil semua event yang sudah "datang" (pollEvent), terapkan ke
+// ViewState, render jika perlu, lalu tunggu tick refresh berikutnya (setFramerateLimit).
+// Latensi = selesai frame - waktu input yang memicu redraw. Input lain yang tiba sebelum frame
+// itu selesai digabung (coalesced). Frame terlewat = tick refresh yang lewat tanpa frame baru
+// selama ada input yang menunggu.
+void run_gui_replay(const ReplayConfig& cfg) {
+    int width = 0, height = 0;
+    std::vector<InputEvent> events;
+    if (!load_input_recording(cfg.path, width, height, events)) {
+        std::cerr << "Error: Gagal membaca rekaman event " << cfg.path << "\n";
+        return;
+    }
+    std::cout << "Replay " << cfg.path << ": " << events.size() << " event, " << width << "x" << height
+              << ", backend " << (cfg.auto_backend ? "auto" : backend_name(cfg.backend))
+              << (cfg.fast ? ", jeda idle dilompati" : "") << "\n";
+
+    ViewState state(width, height);
+    std::vector<uint8_t> rgb(static_cast<size_t>(width) * height * 3), rgba(static_cast<size_t>(width) * height * 4);
+    Renderer renderer;
+    Backend backend = cfg.backend;
+    BackendSelector selector(cfg.profile_path);
+    if (cfg.auto_backend) selector.load_or_calibrate(renderer);
+    long long backend_frames[BACKEND_COUNT] = {};
+    std::vector<double> prediction_errors; // |prediksi - aktual| / aktual
+    IterationCache cache;
+    JuliaInset inset(width, height);
+    std::vector<double> inset_times;
+    long long reuse_frames = 0, reused_pixels = 0, reuse_frame_pixels = 0;
+    double reuse_ms = 0.0;
+    // Notch pertama setelah frame backend (awal, pan, zoom kotak, Julia): cache berasal dari backend
+    IterationCache* fill_cache = cfg.reuse ? &cache : nullptr;
+    bool cache_from_backend = false;
+    long long first_notch_frames = 0, first_notch_reused = 0, first_notch_pixels = 0;
+
+    const double period_ms = 1000.0 / std::max(1.0, cfg.refresh_hz);
+    const auto start = std::chrono::steady_clock::now();
+    double skipped_ms = 0.0; // waktu idle yang dilompati (--fast)
+    auto now_ms = [&] {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() + skipped_ms;
+    };
+
+    std::vector<double> latencies, render_times, pending;
+    long long frames = 0, coalesced = 0, dropped = 0, view_inputs = 0;
+    size_t next = 0;
+    bool closed = false;
+    double next_tick = 0.0;
+
+    auto frame_due = [&] { return state.needs_redraw || (state.split_view && state.inset_dirty); };
+    while (!closed && (next < events.size() || frame_due())) {
+        if (cfg.fast && !frame_due() && next < events.size() && events[next].t_ms > now_ms())
+            skipped_ms += events[next].t_ms - now_ms();
+
+        double now = now_ms();
+        for (; next < events.size() && events[next].t_ms <= now; ++next) {
+            InputEffects fx = apply_input(state, events[next]);
+            if (fx.hud_toggled) g_profiler.enabled = state.show_hud || g_profiler.record_trace;
+            if (fx.redraw_requested || fx.inset_requested) { pending.push_back(events[next].t_ms); view_inputs++; }
+            if (fx.close_requested) { closed = true; break; }
+        }
+
+        if (frame_due()) {
+            g_profiler.begin_frame();
+            double render_start = now_ms();
+            if (!state.needs_redraw) {
+                // Hanya inset berubah: base Mandelbrot tetap dari cache
+            } else if (state.grid_step && cfg.reuse) {
+                ReuseStats rs = render_view_reuse(cache, state, rgb, rgba);
+                reuse_frames++;
+                reused_pixels += rs.reused;
+                reuse_frame_pixels += rs.reused + rs.computed;
+                reuse_ms += rs.elapsed_ms;
+                if (cache_from_backend) {
+                    first_notch_frames++;
+                    first_notch_reused += rs.reused;
+                    first_notch_pixels += rs.reused + rs.computed;
+                    cache_from_backend = false;
+                }
+            } else if (cfg.auto_backend) {
+                BackendChoice choice;
+                RenderResult result = render_view_auto(renderer, selector, state, rgb, rgba, &choice, fill_cache);
+                backend = result.backend;
+                if (result.ok && result.backend == choice.backend) {
+                    double predicted = choice.predicted_ms[static_cast<int>(choice.backend)];
+                    prediction_errors.push_back(std::abs(predicted - result.elapsed_ms) / std::max(result.elapsed_ms, 0.05));
+                }
+            } else {
+                render_view(renderer, backend, state, rgb, rgba, fill_cache);
+            }
+            if (state.needs_redraw && (!state.grid_step || !cfg.reuse)) {
+                backend_frames[static_cast<int>(backend)]++;
+                cache_from_backend = cache.valid;
+            }
+            state.grid_step = false;
+            if (state.split_view && state.inset_dirty) {
+                render_julia_inset(inset, state);
+                inset_times.push_back(inset.last_ms);
+                state.inset_dirty = false;
+            }
+            double done = now_ms();
+            g_profiler.end_frame();
+            state.needs_redraw = false;
+            frames++;
+            render_times.push_back(done - render_start);
+            // State awal (needs_redraw = true tanpa input) tidak dihitung sebagai latensi input
+            for (double t : pending) latencies.push_back(done - t);
+            if (!pending.empty()) {
+                coalesced += static_cast<long long>(pending.size()) - 1;
+                dropped += std::max(0LL, static_cast<long long>(std::ceil((done - pending.front()) / period_ms)) - 1);
+            }
+            pending.clear();
+        }
+
+        // Pembatas frame rate seperti window.display() dengan setFramerateLimit
+        next_tick += period_ms;
+        double wait = next_tick - now_ms();
+        if (wait > 0) std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(wait));
+        else next_tick = now_ms();
+    }
+    double total_s = now_ms() / 1e3;
+
+    auto pct = [](std::vector<double> v, double p) {
+        if (v.empty()) return 0.0;
+        std::sort(v.begin(), v.end());
+        return v[std::min(v.size() - 1, static_cast<size_t>(std::ceil(p * v.size())) - 1)];
+    };
+    double max_latency = latencies.empty() ? 0.0 : *std::max_element(latencies.begin(), latencies.end());
+    std::cout << std::fixed << std::setprecision(2)
+              << "Frame: " << frames << " dalam " << total_s << " s (render median " << pct(render_times, 0.5)
+              << " ms, p99 " << pct(render_times, 0.99) << " ms), backend akhir " << backend_name(backend) << "\n"
+              << "Input yang mengubah view: " << view_inputs << ", digabung ke frame yang sama: " << coalesced
+              << ", frame terlewat (@" << cfg.refresh_hz << " Hz): " << dropped << "\n"
+              << "Latensi input->frame: p50 " << pct(latencies, 0.50) << " ms, p90 " << pct(latencies, 0.90)
+              << " ms, p99 " << pct(latencies, 0.99) << " ms, max " << max_latency << " ms\n";
+    if (!inset_times.empty()) {
+        std::cout << "Inset Julia: " << inset_times.size() << " render (median " << pct(inset_times, 0.5) << " ms, p99 "
+                  << pct(inset_times, 0.99) << " ms, budget " << inset.budget_ms << " ms), akhir " << inset.render_w
+                  << "x" << inset.render_h << " @ " << inset.max_iterations << " iterasi\n";
+    }
+    if (reuse_frames > 0) {
+        std::cout << "Zoom roda: " << reuse_frames << " frame (render rata-rata " << reuse_ms / reuse_frames
+                  << " ms), sampel dipakai ulang " << 100.0 * reused_pixels / std::max(1LL, reuse_frame_pixels) << "%\n";
+        if (first_notch_frames > 0)
+            std::cout << "Notch pertama setelah frame backend: " << first_notch_frames << " frame, sampel dipakai ulang "
+                      << 100.0 * first_notch_reused / std::max(1LL, first_notch_pixels) << "%\n";
+    }
+    if (cfg.auto_backend) {
+        std::cout << "Backend auto: serial " << backend_frames[0] << ", openmp " << backend_frames[1] << ", opencl "
+                  << backend_frames[2] << " frame; kesalahan prediksi median "
+                  << 100.0 * pct(prediction_errors, 0.5) << "%, p90 " << 100.0 * pct(prediction_errors, 0.9) << "%\n";
+        if (!selector.save()) std::cerr << "Error: Gagal menulis profil backend " << selector.path() << "\n";
+    }
+
+    if (!cfg.output_prefix.empty()) {
+        std::ofstream out(cfg.output_prefix + ".json");
+        if (!out) { std::cerr << "Error: Gagal menulis " << cfg.output_prefix << ".json\n"; return; }
+        out << std::fixed << std::setprecision(4)
+            << "{\n  \"recording\": \"" << cfg.path << "\",\n  \"backend\": \""
+            << (cfg.auto_backend ? "auto" : backend_name(backend)) << "\",\n"
+            << "  \"width\": " << width << ",\n  \"height\": " << height << ",\n"
+            << "  \"events\": " << events.size() << ",\n  \"view_inputs\": " << view_inputs << ",\n"
+            << "  \"frames\": " << frames << ",\n  \"coalesced_inputs\": " << coalesced << ",\n"
+            << "  \"dropped_frames\": " << dropped << ",\n  \"refresh_hz\": " << cfg.refresh_hz << ",\n"
+            << "  \"render_median_ms\": " << pct(render_times, 0.5) << ",\n"
+            << "  \"latency_p50_ms\": " << pct(latencies, 0.50) << ",\n  \"latency_p90_ms\": " << pct(latencies, 0.90) << ",\n"
+            << "  \"latency_p99_ms\": " << pct(latencies, 0.99) << ",\n  \"latency_max_ms\": " << max_latency;
+        out << ",\n  \"inset_renders\": " << inset_times.size() << ",\n  \"inset_median_ms\": " << pct(inset_times, 0.5);
+        out << ",\n  \"reuse_frames\": " << reuse_frames << ",\n  \"reused_sample_fraction\": "
+            << static_cast<double>(reused_pixels) / std::max(1LL, reuse_frame_pixels);
+        out << ",\n  \"first_notch_frames\": " << first_notch_frames << ",\n  \"first_notch_reused_fraction\": "
+            << static_cast<double>(first_notch_reused) / std::max(1LL, first_notch_pixels);
+        if (cfg.auto_backend)
+            out << ",\n  \"frames_per_backend\": {\"serial\": " << backend_frames[0] << ", \"openmp\": " << backend_frames[1]
+                << ", \"opencl\": " << backend_frames[2] << "},\n  \"prediction_error_median\": " << pct(prediction_errors, 0.5);
+        out << "\n}\n";
+        std::cout << "Hasil: " << cfg.output_prefix << ".json\n";
+    }
+}
@@ -0,0 +1,135 @@
+/**
+ * gui_replay.hpp
+ * Logika view GUI yang tidak bergantung pada SFML, sehingga aliran event yang sama bisa:
+ * - dipakai langsung oleh run_interactive_gui (event SFML diterjemahkan ke InputEvent)
+ * - direkam ke file teks (--record) lalu diputar ulang tanpa window (--replay)
+ * Replay menjalankan update view + render yang sama dengan GUI dan melaporkan latensi
+ * input-ke-frame (p50/p90/p99), frame yang terlewat, dan input yang digabung ke satu frame.
+ */
+#pragma once
+
+#include <complex>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "backend_selector.hpp"
+#include "fractal_renderer.hpp"
+#include "zoom_reuse.hpp"
+
+enum class InputKind { Key, MouseDown, MouseUp, MouseMove, Wheel, Close };
+
+struct InputEvent {
+    double t_ms = 0.0;      // waktu sejak awal sesi
+    InputKind kind = InputKind::MouseMove;
+    char key = 0;           // Key: huruf kapital ('J', 'R', 'S', 'H', 'L', 'V')
+    char button = 0;        // MouseDown/MouseUp: 'L' atau 'R'
+    int x = 0, y = 0;       // posisi mouse (piksel window)
+    int wheel = 0;          // Wheel: jumlah langkah, positif = zoom masuk (2x per langkah)
+};
+
+// Seluruh state yang menentukan frame berikutnya
+struct ViewState {
+    int width = 0, height = 0;
+    float min_re = -2.0f, max_re = 1.0f, min_im = -1.2f, max_im = 1.2f;
+    bool is_julia = false;
+    std::complex<float> julia_c = {-0.7f, 0.27015f};
+    bool julia_locked = false;
+    bool show_hud = false;
+
+    // Split view: base Mandelbrot di-cache, inset Julia kecil untuk konstanta di bawah kursor.
+    // Gerak mouse hanya menandai inset kotor; 'L' me-render Julia penuh untuk konstanta itu.
+    bool split_view = false;
+    std::complex<float> inset_c = {-0.7f, 0.27015f};
+    bool inset_dirty = false;
+
+    bool is_zooming = false;
+    float zoom_start_x = 0, zoom_start_y = 0;
+    bool right_dragging = false;
+    int last_mouse_x = 0, last_mouse_y = 0;
+    int mouse_x = 0, mouse_y = 0;
+
+    bool needs_redraw = true;
+    bool grid_step = false; // redraw tertunda hanya berasal dari zoom roda (grid sejajar, pakai ulang sampel)
+
+    ViewState(int w, int h) : width(w), height(h) { reset_view(); }
+    void reset_view();
+};
+
+// Efek samping yang harus ditangani pemanggil (GUI: simpan file, judul window, dll.)
+struct InputEffects {
+    bool redraw_requested = false;
+    bool save_requested = false;
+    bool mode_changed = false;
+    bool lock_changed = false;
+    bool hud_toggled = false;
+    bool split_changed = false;
+    bool inset_requested = false;
+    bool close_requested = false;
+};
+
+InputEffects apply_input(ViewState& state, const InputEvent& event);
+
+RenderRequest make_view_request(const ViewState& state, Backend backend);
+
+// Render frame dari state (RGB ke `rgb`, lalu konversi RGBA ke `rgba`), sama seperti GUI.
+// Jika OpenCL gagal, backend diganti ke OpenMP dan render diulang. Jika `cache` diberikan, backend
+// juga menulis buffer iterasinya sehingga zoom roda berikutnya bisa memakai ulang sampel frame ini.
+RenderResult render_view(Renderer& renderer, Backend& backend, const ViewState& state,
+                         std::vector<uint8_t>& rgb, std::vector<uint8_t>& rgba, IterationCache* cache = nullptr);
+
+// Inset Julia split view. Resolusi (faktor downsampling) dan batas iterasi disesuaikan setelah
+// setiap render agar waktu render tetap di bawah budget_ms, sehingga browsing konstanta tidak
+// menurunkan frame rate. Hasilnya RGBA render_w x render_h, ditampilkan diperbesar ke kotak
+// display_w x display_h di pojok kanan bawah window.
+struct JuliaInset {
+    int display_w = 0, display_h = 0;
+    int scale = 2;              // 1, 2, 4, 8: piksel display per piksel render
+    int max_iterations = 256;
+    double budget_ms = 8.0;     // setengah frame 60 Hz; sisanya untuk event + present
+    int render_w = 0, render_h = 0;
+    std::vector<uint8_t> rgb, rgba;
+    std::complex<float> c;
+    double last_ms = 0.0;
+
+    JuliaInset(int window_w, int window_h);
+};
+
+void render_julia_inset(JuliaInset& inset, const ViewState& state);
+
+// Seperti render_view, tetapi backend dipilih per frame oleh selector dan waktu aktual
+// dimasukkan kembali ke model. `choice` (opsional) menerima prediksi untuk logging.
+RenderResult render_view_auto(Renderer& renderer, BackendSelector& selector, const ViewState& state,
+                              std::vector<uint8_t>& rgb, std::vector<uint8_t>& rgba, BackendChoice* choice = nullptr,
+                              IterationCache* cache = nullptr);
+
+// Render untuk langkah zoom roda: sampel yang sejajar diambil dari cache (zoom_reuse.hpp).
+ReuseStats render_view_reuse(IterationCache& cache, const ViewState& state,
+                             std::vector<uint8_t>& rgb, std::vector<uint8_t>& rgba);
+
+// Format file: baris "size W H" lalu satu event per baris ("<t_ms> key J", "<t_ms> down L x y",
+// "<t_ms> up R x y", "<t_ms> move x y", "<t_ms> wheel D x y", "<t_ms> close"). Baris '#' adalah komentar.
+class InputRecorder {
+public:
+    bool open(const std::string& path, int width, int height);
+    bool is_open() const { return out.is_open(); }
+    void record(const InputEvent& event);
+private:
+    std::ofstream out;
+};
+
+bool load_input_recording(const std::string& path, int& width, int& height, std::vector<InputEvent>& events);
+
+struct ReplayConfig {
+    std::string path;
+    Backend backend = Backend::OpenMP;
+    bool auto_backend = false;         // pilih backend per frame dengan BackendSelector
+    std::string profile_path = DEFAULT_BACKEND_PROFILE;
+    bool reuse = true;                 // false = zoom roda dirender penuh (pembanding)
+    bool fast = false;                 // lompati jeda idle (tanpa input & tanpa frame tertunda)
+    double refresh_hz = 60.0;          // sama dengan setFramerateLimit(60) di GUI
+    std::string output_prefix;         // kosong = tanpa JSON
+};
+
+void run_gui_replay(const ReplayConfig& cfg);
@@ -0,0 +1,191 @@
+/**
+ * iteration_field.cpp
+ * Implementasi penulisan/pembacaan file field iterasi (.frf) dan mode --field / --colorize-field.
+ */
+#include "iteration_field.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <fcntl.h>
+#include <omp.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "stb_image_write.h"
+
+static uint64_t align_up(uint64_t bytes) {
+    return (bytes + FIELD_ALIGNMENT - 1) / FIELD_ALIGNMENT * FIELD_ALIGNMENT;
+}
+
+// =======================================================================================
+// FILE FIELD
+// =======================================================================================
+
+bool create_field_file(const std::string& path, const FieldHeader& params, MappedField& out) {
+    FieldHeader hdr = params;
+    std::memcpy(hdr.magic, FIELD_MAGIC, sizeof(hdr.magic));
+    hdr.version = FIELD_VERSION;
+    hdr.header_bytes = FIELD_HEADER_BYTES;
+    hdr.plane_count = FIELD_PLANE_COUNT;
+    hdr.reserved0 = 0;
+
+    const char* names[FIELD_PLANE_COUNT] = {"iter", "smooth", "norm"};
+    const uint32_t types[FIELD_PLANE_COUNT] = {FIELD_INT32, FIELD_FLOAT32, FIELD_FLOAT32};
+    uint64_t offset = FIELD_HEADER_BYTES;
+    for (int i = 0; i < FIELD_PLANE_COUNT; ++i) {
+        FieldPlaneDesc& p = hdr.planes[i];
+        std::memset(&p, 0, sizeof(p));
+        std::strncpy(p.name, names[i], sizeof(p.name) - 1);
+        p.type = types[i];
+        p.element_bytes = 4;
+        p.offset = offset;
+        p.row_stride = static_cast<uint64_t>(hdr.width) * p.element_bytes;
+        p.bytes = p.row_stride * hdr.height;
+        offset = align_up(offset + p.bytes);
+    }
+    hdr.file_bytes = offset;
+
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    if (ftruncate(fd, static_cast<off_t>(hdr.file_bytes)) != 0) { close(fd); return false; }
+    void* mem = mmap(nullptr, hdr.file_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) return false;
+    out.base = static_cast<uint8_t*>(mem);
+    out.bytes = hdr.file_bytes;
+    out.header = reinterpret_cast<FieldHeader*>(out.base);
+    std::memcpy(out.header, &hdr, sizeof(hdr));
+    return true;
+}
+
+bool open_field_file(const std::string& path, MappedField& out) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(FIELD_HEADER_BYTES)) { close(fd); return false; }
+    void* mem = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) return false;
+    out.base = static_cast<uint8_t*>(mem);
+    out.bytes = static_cast<size_t>(st.st_size);
+    out.header = reinterpret_cast<FieldHeader*>(out.base);
+
+    const FieldHeader& h = *out.header;
+    bool ok = std::memcmp(h.magic, FIELD_MAGIC, sizeof(h.magic)) == 0 && h.version == FIELD_VERSION &&
+              h.width >= 1 && h.height >= 1 && h.plane_count >= FIELD_PLANE_COUNT && h.file_bytes <= out.bytes;
+    for (int i = 0; ok && i < FIELD_PLANE_COUNT; ++i) {
+        const FieldPlaneDesc& p = h.planes[i];
+        ok = p.element_bytes == 4 && p.offset % FIELD_ALIGNMENT == 0 && p.offset + p.bytes <= out.bytes &&
+             p.row_stride == static_cast<uint64_t>(h.width) * 4 && p.bytes == p.row_stride * h.height;
+    }
+    if (!ok) { close_field_file(out); return false; }
+    return true;
+}
+
+void close_field_file(MappedField& field) {
+    if (field.base) munmap(field.base, field.bytes);
+    field = MappedField();
+}
+
+// =======================================================================================
+// MODE --field: RENDER LANGSUNG KE FILE
+// =======================================================================================
+
+void run_field_render(const FieldRenderConfig& cfg) {
+    FieldHeader params;
+    std::memset(&params, 0, sizeof(params));
+    params.width = cfg.width; params.height = cfg.height;
+    params.max_iterations = cfg.max_iterations;
+    params.is_julia = cfg.is_julia ? 1 : 0;
+    params.min_re = cfg.min_re; params.max_re = cfg.max_re; params.min_im = cfg.min_im;
+    params.max_im = cfg.min_im + (cfg.max_re - cfg.min_re) * static_cast<double>(cfg.height) / cfg.width;
+    params.julia_re = cfg.julia_c.real(); params.julia_im = cfg.julia_c.imag();
+    params.bailout = 2.0;
+
+    MappedField field;
+    if (!create_field_file(cfg.path, params, field)) {
+        std::cerr << "Error: Gagal membuat file field " << cfg.path << "\n";
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    generate_iteration_field_parallel(field.iterations(), field.smooth(), field.final_norm(), cfg.width, cfg.height,
+                                      cfg.min_re, cfg.max_re, cfg.min_im, static_cast<float>(params.max_im),
+                                      cfg.is_julia, cfg.julia_c, cfg.max_iterations);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (!cfg.png_path.empty()) {
+        std::vector<uint8_t> pixels(static_cast<size_t>(cfg.width) * cfg.height * 3);
+        const int32_t* iters = field.iterations();
+        #pragma omp parallel for
+        for (long long i = 0; i < static_cast<long long>(cfg.width) * cfg.height; ++i) {
+            Color color = map_iteration_to_color(iters[i], cfg.max_iterations);
+            pixels[i * 3] = color.r; pixels[i * 3 + 1] = color.g; pixels[i * 3 + 2] = color.b;
+        }
+        stbi_write_png(cfg.png_path.c_str(), cfg.width, cfg.height, 3, pixels.data(), cfg.width * 3);
+    }
+    std::cout << std::fixed << std::setprecision(2) << "Field " << cfg.width << "x" << cfg.height << " ("
+              << field.bytes / 1048576.0 << " MiB) dirender dalam " << ms << " ms -> " << cfg.path
+              << (cfg.png_path.empty() ? "" : ", " + cfg.png_path) << "\n";
+    close_field_file(field);
+}
+
+// =======================================================================================
+// MODE --colorize-field: WARNAI ULANG TANPA RENDER ULANG
+// =======================================================================================
+
+void run_field_colorize(const FieldColorizeConfig& cfg) {
+    MappedField field;
+    if (!open_field_file(cfg.path, field)) {
+        std::cerr << "Error: " << cfg.path << " bukan file field yang valid\n";
+        return;
+    }
+    const FieldHeader& h = *field.header;
+    const int max_it = h.max_iterations;
+    const int32_t* iters = field.iterations();
+    const float* smooth = field.smooth();
+    const float* norm = field.final_norm();
+    const int palette = cfg.palette == "smooth" ? 1 : (cfg.palette == "cyclic" ? 2 : 0);
+    if (palette == 0 && cfg.palette != "classic") std::cerr << "Palet tidak dikenal: " << cfg.palette << ", memakai classic\n";
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint8_t> pixels(static_cast<size_t>(h.width) * h.height * 3);
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < static_cast<long long>(h.width) * h.height; ++i) {
+        Color color;
+        if (iters[i] >= max_it) {
+            color = {0, 0, 0};
+        } else if (palette == 0) {
+            color = map_iteration_to_color(iters[i], max_it);
+        } else if (palette == 1) {
+            // Palet polinomial yang sama dengan map_iteration_to_color, tetapi t kontinu
+            float t = std::min(1.0f, std::max(0.0f, smooth[i] / max_it));
+            color = {static_cast<uint8_t>(9 * (1 - t) * t * t * t * 255),
+                     static_cast<uint8_t>(15 * (1 - t) * (1 - t) * t * t * 255),
+                     static_cast<uint8_t>(8.5 * (1 - t) * (1 - t) * (1 - t) * t * 255)};
+        } else {
+            // Pita periodik setiap `cycle` iterasi halus, tidak bergantung pada max_iterations
+            float t = 0.5f - 0.5f * std::cos(6.2831853f * smooth[i] / cfg.cycle);
+            color = {static_cast<uint8_t>(255 * t), static_cast<uint8_t>(255 * (0.3f + 0.7f * t * t)),
+                     static_cast<uint8_t>(255 * (1.0f - 0.6f * t))};
+        }
+        if (cfg.shade && iters[i] < max_it) {
+            // |z|^2 dekat bailout (4) = baru saja lolos -> lebih terang
+            float s = std::min(1.0f, std::max(0.35f, 2.0f / std::sqrt(std::max(norm[i], 4.0f)) + 0.2f));
+            color = {static_cast<uint8_t>(color.r * s), static_cast<uint8_t>(color.g * s), static_cast<uint8_t>(color.b * s)};
+        }
+        pixels[i * 3] = color.r; pixels[i * 3 + 1] = color.g; pixels[i * 3 + 2] = color.b;
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    stbi_write_png(cfg.png_path.c_str(), h.width, h.height, 3, pixels.data(), h.width * 3);
+    std::cout << std::fixed << std::setprecision(2) << "Field " << cfg.path << " (" << h.width << "x" << h.height
+              << ", iterasi maks " << max_it << ") diwarnai dengan palet " << cfg.palette << (cfg.shade ? " + shading" : "")
+              << " dalam " << ms << " ms -> " << cfg.png_path << "\n";
+    close_field_file(field);
+}
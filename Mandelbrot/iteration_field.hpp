@@ -0,0 +1,85 @@
+/**
+ * iteration_field.hpp
+ * Format file field iterasi mentah (.frf) yang bisa di-mmap langsung oleh tool lain
+ * (recolor, compositing, analisis) tanpa parsing dan tanpa decode PNG.
+ *
+ * Layout (little-endian, semua offset kelipatan 4096):
+ *   [0, 4096)  FieldHeader (di bawah), sisanya nol
+ *   plane 0    "iter"   int32   width x height, row-major     jumlah iterasi (== max_iterations untuk interior)
+ *   plane 1    "smooth" float32 width x height, row-major     n + 1 - log2(log2|z|) (== n untuk interior)
+ *   plane 2    "norm"   float32 width x height, row-major     |z|^2 terakhir
+ * Offset dan ukuran setiap plane ada di FieldHeader::planes, sehingga pembaca cukup
+ * mmap file lalu menunjuk ke base + planes[i].offset.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "fractal_renderer.hpp"
+
+const char FIELD_MAGIC[8] = {'F', 'R', 'F', 'I', 'E', 'L', 'D', '1'};
+const uint32_t FIELD_VERSION = 1;
+const uint32_t FIELD_HEADER_BYTES = 4096;
+const uint32_t FIELD_ALIGNMENT = 4096;
+
+enum FieldPlaneType : uint32_t { FIELD_INT32 = 1, FIELD_FLOAT32 = 2 };
+enum FieldPlaneIndex { FIELD_PLANE_ITER = 0, FIELD_PLANE_SMOOTH = 1, FIELD_PLANE_NORM = 2, FIELD_PLANE_COUNT = 3 };
+
+struct FieldPlaneDesc {
+    char name[16];
+    uint32_t type;          // FieldPlaneType
+    uint32_t element_bytes;
+    uint64_t offset;        // dari awal file, kelipatan FIELD_ALIGNMENT
+    uint64_t row_stride;    // byte per baris
+    uint64_t bytes;
+};
+
+struct FieldHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_bytes;
+    int32_t width, height, max_iterations, is_julia;
+    double min_re, max_re, min_im, max_im, julia_re, julia_im;
+    double bailout;
+    uint32_t plane_count, reserved0;
+    uint64_t file_bytes;
+    FieldPlaneDesc planes[FIELD_PLANE_COUNT];
+};
+
+// Field yang sedang di-mmap (hasil create_field_file / open_field_file)
+struct MappedField {
+    FieldHeader* header = nullptr;
+    uint8_t* base = nullptr;
+    size_t bytes = 0;
+    int32_t* iterations() const { return reinterpret_cast<int32_t*>(base + header->planes[FIELD_PLANE_ITER].offset); }
+    float* smooth() const { return reinterpret_cast<float*>(base + header->planes[FIELD_PLANE_SMOOTH].offset); }
+    float* final_norm() const { return reinterpret_cast<float*>(base + header->planes[FIELD_PLANE_NORM].offset); }
+};
+
+struct FieldRenderConfig {
+    std::string path = "field.frf";
+    int width = 1920, height = 1080;
+    float min_re = -2.0f, max_re = 1.0f, min_im = -1.2f;
+    bool is_julia = false;
+    std::complex<float> julia_c = {0, 0};
+    int max_iterations = MAX_ITERATIONS;
+    std::string png_path;   // kosong = hanya field
+};
+
+struct FieldColorizeConfig {
+    std::string path;
+    std::string png_path = "field.png";
+    std::string palette = "classic"; // classic | smooth | cyclic
+    float cycle = 64.0f;             // periode (iterasi) untuk palet cyclic
+    bool shade = false;              // gelapkan berdasarkan |z|^2 (jarak escape)
+};
+
+// Membuat file dengan ukuran akhir lalu mmap read-write; plane siap diisi generator.
+bool create_field_file(const std::string& path, const FieldHeader& params, MappedField& out);
+// mmap read-only dan validasi header.
+bool open_field_file(const std::string& path, MappedField& out);
+void close_field_file(MappedField& field);
+
+void run_field_render(const FieldRenderConfig& cfg);
+void run_field_colorize(const FieldColorizeConfig& cfg);
@@ -1,11 +1,21 @@
 /**
  * Program Generator Fraktal (Versi Final - GUI + Benchmark)
  * - Mode GUI Interaktif (default)
- * - Mode Benchmark dengan flag --benchmark (Serial, Paralel, GPU)
+ * - Mode Benchmark dengan flag --benchmark (Serial, Paralel, GPU; median/p95/stddev, output JSON/CSV)
+ * - Mode Atlas Julia dengan flag --atlas (grid konstanta c dalam satu peluncuran)
+ * - Mode Buddhabrot/Anti-Buddhabrot dengan flag --buddhabrot / --anti-buddhabrot
+ * - Mode Server Tile HTTP dengan flag --serve, load generator dengan --loadgen
+ * - Mode Render Terdistribusi dengan flag --coordinator / --worker
+ * - Mode Video Zoom Exponential Map dengan flag --expmap
+ * - Rekam sesi GUI dengan --record, putar ulang tanpa window dengan --replay (latensi input->frame)
+ * - Render panjang yang bisa dilanjutkan dengan --checkpoint, progress/ETA dengan --checkpoint-status
+ * - Field iterasi mentah (.frf, bisa di-mmap) dengan --field, pewarnaan ulang dengan --colorize-field
+ * - Pemilihan backend otomatis dari model biaya (GUI, --replay auto), kalibrasi dengan --calibrate-backends
+ * - Streaming explorer lewat TCP (delta tile) dengan --stream-server / --stream-view, benchmark --stream-bench
  * - Resolusi Dinamis, Menyimpan Gambar, Mengunci Julia
+ * Engine rendering ada di library fractal_renderer (fractal_renderer.hpp/.cpp).
  */
 #define ENABLE_SFML_GUI
-#define ENABLE_OPENCL
 
 #include <iostream>
 #include <vector>
@@ -15,16 +25,27 @@
 #include <string>
 #include <iomanip>
 #include <sstream>
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <cstdint>
+#include <mutex>
 
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb_image_write.h"
 
 #include <omp.h>
 
-#ifdef ENABLE_OPENCL
-#define CL_HPP_ENABLE_EXCEPTIONS
-#include <CL/opencl.hpp>
-#endif
+#include "fractal_renderer.hpp" // mendefinisikan ENABLE_OPENCL
+#include "numa_render.hpp"
+#include "tile_server.hpp"
+#include "distributed_render.hpp"
+#include "expmap_zoom.hpp"
+#include "gui_replay.hpp"
+#include "checkpoint_render.hpp"
+#include "iteration_field.hpp"
+#include "backend_selector.hpp"
+#include "frame_stream.hpp"
 
 #ifdef ENABLE_SFML_GUI
 #include <SFML/Graphics.hpp>
@@ -32,236 +53,565 @@
 
 const int DEFAULT_WIDTH = 1920;
 const int DEFAULT_HEIGHT = 1080;
-const int MAX_ITERATIONS = 1000;
+// =======================================================================================
+// MODE OPERASI PROGRAM
+// =======================================================================================
 
-struct Color { uint8_t r, g, b; };
+// --- Mode Benchmark ---
+// Setiap skenario dijalankan beberapa kali (warmup dibuang) lalu diringkas dengan median/p95/stddev.
+// Setup OpenCL, waktu kernel, readback, dan colorize diukur terpisah. Hasil ditulis ke JSON dan CSV.
+struct BenchScenario {
+    const char* name;
+    float min_re, max_re, min_im;
+    bool is_julia;
+    std::complex<float> julia_c;
+};
 
-Color map_iteration_to_color(int iterations) {
-    if (iterations == MAX_ITERATIONS) return {0, 0, 0};
-    float t = static_cast<float>(iterations) / MAX_ITERATIONS;
-    uint8_t r = static_cast<uint8_t>(9 * (1 - t) * t * t * t * 255);
-    uint8_t g = static_cast<uint8_t>(15 * (1 - t) * (1 - t) * t * t * 255);
-    uint8_t b = static_cast<uint8_t>(8.5 * (1 - t) * (1 - t) * (1 - t) * t * 255);
-    return {r, g, b};
-}
+struct BenchStats {
+    int samples = 0;
+    double mean = 0, median = 0, p95 = 0, stddev = 0, min = 0, max = 0;
+};
 
-// =======================================================================================
-// FUNGSI-FUNGSI GENERATOR FRAKTAL (SERIAL, PARALEL, GPU)
-// =======================================================================================
+struct BenchRecord {
+    std::string scenario, backend, stage;
+    int width, height, threads;
+    BenchStats stats;
+};
 
-// --- Implementasi Serial (DIKEMBALIKAN) ---
-void generate_fractal_serial(
-    std::vector<uint8_t>& pixels, int width, int height,
-    float min_re, float max_re, float min_im, float max_im)
-{
-    float re_range = max_re - min_re;
-    float im_range = max_im - min_im;
-
-    for (int py = 0; py < height; ++py) {
-        for (int px = 0; px < width; ++px) {
-            float cx = min_re + static_cast<float>(px) / (width - 1) * re_range;
-            float cy = min_im + static_cast<float>(py) / (height - 1) * im_range;
-
-            std::complex<float> z = {0,0};
-            std::complex<float> c = {cx, cy};
-
-            int iterations = 0;
-            while (iterations < MAX_ITERATIONS) {
-                if (std::abs(z) > 2.0f) break;
-                z = z * z + c;
-                iterations++;
-            }
+struct BenchConfig {
+    int width = DEFAULT_WIDTH;
+    int height = DEFAULT_HEIGHT;
+    int warmup = 1;
+    int repetitions = 5;
+    std::vector<int> thread_counts; // kosong = 1, 2, 4, ... hingga omp_get_max_threads()
+    std::string output_prefix = "benchmark_results";
+    bool numa = false;              // paksa varian openmp_numa (otomatis aktif jika host > 1 node)
+    PinPolicy pin = PinPolicy::None;
+};
 
-            Color color = map_iteration_to_color(iterations);
-            size_t index = (py * width + px) * 3;
-            pixels[index]     = color.r;
-            pixels[index + 1] = color.g;
-            pixels[index + 2] = color.b;
-        }
+// Lokalitas memori untuk satu (skenario, resolusi, jumlah thread): buffer std::vector biasa
+// vs buffer first-touch, diukur terhadap node pemilik baris di NumaLayout yang sama.
+struct NumaRecord {
+    std::string scenario;
+    int width, height, threads;
+    PageLocality vector_pages, numa_pages;
+    NumaRenderStats rows;
+};
+
+const BenchScenario BENCH_SCENARIOS[] = {
+    {"default",        -2.0f,        1.0f,        -1.2f,       false, {0, 0}},
+    {"interior_heavy", -0.4f,        0.1f,        -0.15f,      false, {0, 0}},
+    {"boundary_heavy", -0.76f,       -0.72f,      0.08f,       false, {0, 0}},
+    {"deep_zoom",      -0.7441439f,  -0.7431439f, 0.1315447f,  false, {0, 0}},
+    {"julia",          -1.6f,        1.6f,        -0.9f,       true,  {-0.7f, 0.27015f}},
+};
+
+BenchStats compute_stats(std::vector<double> samples) {
+    BenchStats st;
+    st.samples = static_cast<int>(samples.size());
+    if (samples.empty()) return st;
+    std::sort(samples.begin(), samples.end());
+    size_t n = samples.size();
+    double sum = 0;
+    for (double v : samples) sum += v;
+    st.mean = sum / n;
+    st.median = (n % 2) ? samples[n / 2] : 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+    st.p95 = samples[static_cast<size_t>(std::ceil(0.95 * n)) - 1]; // nearest-rank
+    double sq = 0;
+    for (double v : samples) sq += (v - st.mean) * (v - st.mean);
+    st.stddev = n > 1 ? std::sqrt(sq / (n - 1)) : 0.0;
+    st.min = samples.front();
+    st.max = samples.back();
+    return st;
+}
+
+template <typename Fn>
+std::vector<double> time_runs(int warmup, int repetitions, Fn&& fn) {
+    for (int i = 0; i < warmup; ++i) fn();
+    std::vector<double> samples;
+    for (int i = 0; i < repetitions; ++i) {
+        g_profiler.begin_frame();
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        g_profiler.end_frame();
+        samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
     }
+    return samples;
 }
 
+void print_bench_record(const BenchRecord& r) {
+    std::cout << std::left << std::setw(15) << r.scenario << std::setw(12) << r.backend << std::setw(10) << r.stage
+              << std::right << std::setw(5) << r.width << "x" << std::left << std::setw(5) << r.height
+              << " thr=" << std::setw(3) << r.threads << std::right << std::fixed << std::setprecision(2)
+              << " median " << std::setw(9) << r.stats.median << " ms"
+              << "  p95 " << std::setw(9) << r.stats.p95 << " ms"
+              << "  sd " << std::setw(7) << r.stats.stddev << " ms"
+              << "  (n=" << r.stats.samples << ")\n";
+}
 
-// --- Implementasi Paralel CPU ---
-void generate_fractal_parallel(
-    std::vector<uint8_t>& pixels, int width, int height,
-    float min_re, float max_re, float min_im, float max_im,
-    bool is_julia = false, std::complex<float> julia_c = {0,0})
+void print_numa_record(const NumaRecord& r, int nodes, PinPolicy pin) {
+    auto pct = [](const PageLocality& p) {
+        std::ostringstream os;
+        if (p.available) os << std::fixed << std::setprecision(1) << 100.0 * p.local_fraction() << "%";
+        else os << "n/a";
+        return os.str();
+    };
+    std::cout << "  numa: node=" << nodes << " pin=" << pin_policy_name(pin)
+              << "  halaman lokal: vector " << pct(r.vector_pages) << " -> first-touch " << pct(r.numa_pages)
+              << "  baris dicuri " << r.rows.rows_stolen << "/" << (r.rows.rows_local + r.rows.rows_stolen) << "\n";
+}
+
+void write_benchmark_json(const std::string& path, const BenchConfig& cfg,
+                          const std::vector<BenchRecord>& records, const std::string& device_name,
+                          const std::vector<NumaRecord>& numa_records)
 {
-    float re_range = max_re - min_re;
-    float im_range = max_im - min_im;
+    std::ofstream out(path);
+    if (!out) { std::cerr << "Error: Gagal menulis " << path << "\n"; return; }
+    std::time_t now_time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    out << std::fixed << std::setprecision(4);
+    out << "{\n"
+        << "  \"timestamp\": \"" << std::put_time(std::localtime(&now_time), "%Y-%m-%dT%H:%M:%S") << "\",\n"
+        << "  \"max_iterations\": " << MAX_ITERATIONS << ",\n"
+        << "  \"max_threads\": " << omp_get_max_threads() << ",\n"
+        << "  \"opencl_device\": \"" << device_name << "\",\n"
+        << "  \"warmup\": " << cfg.warmup << ",\n"
+        << "  \"repetitions\": " << cfg.repetitions << ",\n"
+        << "  \"results\": [\n";
+    for (size_t i = 0; i < records.size(); ++i) {
+        const BenchRecord& r = records[i];
+        out << "    {\"scenario\": \"" << r.scenario << "\", \"backend\": \"" << r.backend
+            << "\", \"stage\": \"" << r.stage << "\", \"width\": " << r.width << ", \"height\": " << r.height
+            << ", \"threads\": " << r.threads << ", \"samples\": " << r.stats.samples
+            << ", \"mean_ms\": " << r.stats.mean << ", \"median_ms\": " << r.stats.median
+            << ", \"p95_ms\": " << r.stats.p95 << ", \"stddev_ms\": " << r.stats.stddev
+            << ", \"min_ms\": " << r.stats.min << ", \"max_ms\": " << r.stats.max << "}"
+            << (i + 1 < records.size() ? "," : "") << "\n";
+    }
+    out << "  ],\n"
+        << "  \"numa_nodes\": " << numa_topology().node_count() << ",\n"
+        << "  \"pin\": \"" << pin_policy_name(cfg.pin) << "\",\n"
+        << "  \"numa_locality\": [\n";
+    for (size_t i = 0; i < numa_records.size(); ++i) {
+        const NumaRecord& r = numa_records[i];
+        out << "    {\"scenario\": \"" << r.scenario << "\", \"width\": " << r.width << ", \"height\": " << r.height
+            << ", \"threads\": " << r.threads << ", \"pages\": " << r.numa_pages.pages
+            << ", \"vector_local_fraction\": " << (r.vector_pages.available ? r.vector_pages.local_fraction() : -1.0)
+            << ", \"first_touch_local_fraction\": " << (r.numa_pages.available ? r.numa_pages.local_fraction() : -1.0)
+            << ", \"rows_local\": " << r.rows.rows_local << ", \"rows_stolen\": " << r.rows.rows_stolen << "}"
+            << (i + 1 < numa_records.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
 
-    #pragma omp parallel for schedule(dynamic)
-    for (int py = 0; py < height; ++py) {
-        for (int px = 0; px < width; ++px) {
-            float cx = min_re + static_cast<float>(px) / (width - 1) * re_range;
-            float cy = min_im + static_cast<float>(py) / (height - 1) * im_range;
+void write_benchmark_csv(const std::string& path, const std::vector<BenchRecord>& records) {
+    std::ofstream out(path);
+    if (!out) { std::cerr << "Error: Gagal menulis " << path << "\n"; return; }
+    out << std::fixed << std::setprecision(4);
+    out << "scenario,backend,stage,width,height,threads,samples,mean_ms,median_ms,p95_ms,stddev_ms,min_ms,max_ms\n";
+    for (const BenchRecord& r : records) {
+        out << r.scenario << ',' << r.backend << ',' << r.stage << ',' << r.width << ',' << r.height << ','
+            << r.threads << ',' << r.stats.samples << ',' << r.stats.mean << ',' << r.stats.median << ','
+            << r.stats.p95 << ',' << r.stats.stddev << ',' << r.stats.min << ',' << r.stats.max << '\n';
+    }
+}
+
+void run_benchmarks(const BenchConfig& cfg) {
+    std::cout << "=================================================\n";
+    std::cout << "            MODE BENCHMARK AKTIF\n";
+    std::cout << "=================================================\n";
+    std::cout << "Resolusi: " << cfg.width << "x" << cfg.height << ", Iterasi Maks: " << MAX_ITERATIONS
+              << ", Warmup: " << cfg.warmup << ", Repetisi: " << cfg.repetitions << "\n\n";
 
-            std::complex<float> z, c;
+    const int max_threads = omp_get_max_threads();
+    std::vector<int> thread_counts = cfg.thread_counts;
+    if (thread_counts.empty()) {
+        for (int t = 1; t < max_threads; t *= 2) thread_counts.push_back(t);
+        thread_counts.push_back(max_threads);
+    }
 
-            if (is_julia) {
-                z = {cx, cy}; c = julia_c;
-            } else {
-                z = {0,0}; c = {cx, cy};
-            }
+    std::vector<std::pair<int, int>> resolutions = {{cfg.width, cfg.height}};
+    if (cfg.width / 2 >= 2 && cfg.height / 2 >= 2) resolutions.push_back({cfg.width / 2, cfg.height / 2});
 
-            int iterations = 0;
-            while (iterations < MAX_ITERATIONS) {
-                if (std::abs(z) > 2.0f) break;
-                z = z * z + c;
-                iterations++;
-            }
+    const int numa_nodes = numa_topology().node_count();
+    const bool run_numa = cfg.numa || numa_nodes > 1;
+    std::cout << "Node NUMA: " << numa_nodes << ", pin: " << pin_policy_name(cfg.pin)
+              << (run_numa ? ", varian openmp_numa aktif" : "") << "\n\n";
 
-            Color color = map_iteration_to_color(iterations);
-            size_t index = (py * width + px) * 3;
-            pixels[index]     = color.r;
-            pixels[index + 1] = color.g;
-            pixels[index + 2] = color.b;
-        }
-    }
-}
+    std::vector<BenchRecord> records;
+    std::vector<NumaRecord> numa_records;
+    auto add_record = [&](const BenchScenario& sc, const char* backend, const char* stage,
+                          int w, int h, int threads, const std::vector<double>& samples) {
+        records.push_back({sc.name, backend, stage, w, h, threads, compute_stats(samples)});
+        print_bench_record(records.back());
+    };
 
-// --- Implementasi GPU ---
-#ifdef ENABLE_OPENCL
-void generate_fractal_gpu(
-    std::vector<uint8_t>& pixels, int width, int height,
-    float min_re, float max_re, float min_im, float max_im,
-    bool is_julia, std::complex<float> julia_c)
-{
+    std::string device_name = "none";
+    #ifdef ENABLE_OPENCL
+    OpenCLContext cl_ctx;
+    bool cl_ready = false;
     try {
-        std::vector<cl::Platform> platforms;
-        cl::Platform::get(&platforms);
-        if (platforms.empty()) throw std::runtime_error("No OpenCL platform found.");
-
-        cl::Device device;
-        for(auto& p : platforms) {
-            std::vector<cl::Device> p_devices;
-            p.getDevices(CL_DEVICE_TYPE_GPU, &p_devices);
-            if(!p_devices.empty()) {
-                device = p_devices.front();
-                break;
+        auto start_setup = std::chrono::steady_clock::now();
+        init_opencl_context(cl_ctx);
+        auto end_setup = std::chrono::steady_clock::now();
+        cl_ready = true;
+        device_name = cl_ctx.device.getInfo<CL_DEVICE_NAME>();
+        double setup_ms = std::chrono::duration<double, std::milli>(end_setup - start_setup).count();
+        add_record(BENCH_SCENARIOS[0], "opencl", "setup", 0, 0, 0, {setup_ms});
+    } catch (const cl::Error& e) {
+        std::cerr << "OpenCL Error: " << e.what() << " (" << e.err() << ")\n";
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Runtime Error: " << e.what() << '\n';
+    }
+    #endif
+
+    for (const BenchScenario& sc : BENCH_SCENARIOS) {
+        for (const auto& res : resolutions) {
+            int w = res.first, h = res.second;
+            std::vector<uint8_t> pixels(w * h * 3);
+            float min_re = sc.min_re, max_re = sc.max_re, min_im = sc.min_im;
+            float max_im = min_im + (max_re - min_re) * static_cast<float>(h) / w;
+
+            // 1. Serial
+            add_record(sc, "serial", "total", w, h, 1, time_runs(cfg.warmup, cfg.repetitions, [&] {
+                generate_fractal_serial(pixels, w, h, min_re, max_re, min_im, max_im, sc.is_julia, sc.julia_c);
+            }));
+
+            // 2. Paralel (OpenMP) untuk setiap jumlah thread
+            for (int t : thread_counts) {
+                omp_set_num_threads(t);
+                add_record(sc, "openmp", "total", w, h, t, time_runs(cfg.warmup, cfg.repetitions, [&] {
+                    generate_fractal_parallel(pixels, w, h, min_re, max_re, min_im, max_im, sc.is_julia, sc.julia_c);
+                }));
+
+                // 2b. OpenMP sadar NUMA: buffer first-touch per node + baris lokal per socket
+                if (run_numa) {
+                    NumaLayout layout = make_numa_layout(t, h, cfg.pin);
+                    NumaFrameBuffer numa_pixels(w, h);
+                    numa_pixels.first_touch(layout);
+                    NumaRecord nr{sc.name, w, h, t, {}, {}, {}};
+                    add_record(sc, "openmp_numa", "total", w, h, t, time_runs(cfg.warmup, cfg.repetitions, [&] {
+                        generate_fractal_parallel_numa(layout, numa_pixels.data(), numa_pixels.stride(), w, h,
+                                                       min_re, max_re, min_im, max_im, sc.is_julia, sc.julia_c,
+                                                       MAX_ITERATIONS, &nr.rows);
+                    }));
+                    nr.vector_pages = measure_page_locality(layout, pixels.data(), static_cast<size_t>(w) * 3, h);
+                    nr.numa_pages = measure_page_locality(layout, numa_pixels.data(), numa_pixels.stride(), h);
+                    print_numa_record(nr, numa_nodes, cfg.pin);
+                    numa_records.push_back(nr);
+                    // Lepas pin agar varian openmp biasa berikutnya tetap diukur seperti semula
+                    if (cfg.pin != PinPolicy::None) unpin_openmp_threads(t);
+                }
             }
-        }
-        if(!device()) { // Fallback to CPU if no GPU found
-            for(auto& p : platforms) {
-                std::vector<cl::Device> p_devices;
-                p.getDevices(CL_DEVICE_TYPE_CPU, &p_devices);
-                if(!p_devices.empty()) {
-                    device = p_devices.front();
-                    break;
+            omp_set_num_threads(max_threads);
+
+            // 3. GPU (OpenCL), tahap dipisah
+            #ifdef ENABLE_OPENCL
+            if (cl_ready) {
+                try {
+                    std::vector<double> total, kernel, readback, colorize, overlap;
+                    for (int i = 0; i < cfg.warmup + cfg.repetitions; ++i) {
+                        GpuTimings tm;
+                        g_profiler.begin_frame();
+                        auto start = std::chrono::steady_clock::now();
+                        generate_fractal_gpu(cl_ctx, pixels, w, h, min_re, max_re, min_im, max_im, sc.is_julia, sc.julia_c, &tm);
+                        auto end = std::chrono::steady_clock::now();
+                        g_profiler.end_frame();
+                        if (i < cfg.warmup) continue;
+                        total.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+                        kernel.push_back(tm.kernel_ms);
+                        readback.push_back(tm.readback_ms);
+                        colorize.push_back(tm.colorize_ms);
+                        overlap.push_back(tm.overlap_ms);
+                    }
+                    add_record(sc, "opencl", "total", w, h, max_threads, total);
+                    add_record(sc, "opencl", "kernel", w, h, 0, kernel);
+                    add_record(sc, "opencl", "readback", w, h, 0, readback);
+                    add_record(sc, "opencl", "colorize", w, h, max_threads, colorize);
+                    add_record(sc, "opencl", "overlap", w, h, 0, overlap);
+                } catch (const cl::Error& e) {
+                    std::cerr << "OpenCL Error: " << e.what() << " (" << e.err() << ")\n";
                 }
             }
+            #endif
         }
-        if(!device()) throw std::runtime_error("No OpenCL device found.");
+    }
 
-        std::cout << "[OpenCL] Using device: " << device.getInfo<CL_DEVICE_NAME>() << std::endl;
+    // Gambar output dari skenario default, di luar pengukuran waktu
+    {
+        int w = cfg.width, h = cfg.height;
+        std::vector<uint8_t> pixels(w * h * 3);
+        float min_re = -2.0f, max_re = 1.0f, min_im = -1.2f;
+        float max_im = min_im + (max_re - min_re) * static_cast<float>(h) / w;
+        generate_fractal_serial(pixels, w, h, min_re, max_re, min_im, max_im);
+        stbi_write_png("fractal_serial.png", w, h, 3, pixels.data(), w * 3);
+        generate_fractal_parallel(pixels, w, h, min_re, max_re, min_im, max_im);
+        stbi_write_png("fractal_parallel_omp.png", w, h, 3, pixels.data(), w * 3);
+        #ifdef ENABLE_OPENCL
+        if (cl_ready) {
+            generate_fractal_gpu(cl_ctx, pixels, w, h, min_re, max_re, min_im, max_im, false, {0,0});
+            stbi_write_png("fractal_gpu_opencl.png", w, h, 3, pixels.data(), w * 3);
+        }
+        #endif
+    }
 
-        cl::Context context(device);
-        cl::CommandQueue queue(context, device);
+    // Ringkasan rasio percepatan berdasarkan median skenario default pada resolusi utama
+    auto median_of = [&](const char* backend, int threads) {
+        for (const BenchRecord& r : records)
+            if (r.scenario == "default" && r.backend == backend && r.stage == "total" &&
+                r.width == cfg.width && r.height == cfg.height && (threads < 0 || r.threads == threads))
+                return r.stats.median;
+        return 0.0;
+    };
+    double serial_ms = median_of("serial", -1);
+    double omp_ms = median_of("openmp", max_threads);
+    std::cout << "\n================  HASIL BENCHMARK  ================\n";
+    std::cout << std::fixed << std::setprecision(2);
+    if (omp_ms > 0) std::cout << "Rasio Percepatan (OpenMP vs Serial) : " << serial_ms / omp_ms << "x\n";
+    #ifdef ENABLE_OPENCL
+    double gpu_ms = median_of("opencl", -1);
+    if (gpu_ms > 0) std::cout << "Rasio Percepatan (OpenCL vs Serial) : " << serial_ms / gpu_ms << "x\n";
+    #endif
+    std::cout << "=================================================\n";
+
+    write_benchmark_json(cfg.output_prefix + ".json", cfg, records, device_name, numa_records);
+    write_benchmark_csv(cfg.output_prefix + ".csv", records);
+    std::cout << "Hasil: " << cfg.output_prefix << ".json, " << cfg.output_prefix << ".csv\n";
+    std::cout << "Gambar output: fractal_serial.png, fractal_parallel_omp.png, fractal_gpu_opencl.png\n";
+}
 
-        std::ifstream kernel_file("mandelbrot_kernel.cl");
-        if (!kernel_file.is_open()) throw std::runtime_error("Failed to open kernel file.");
-        std::string kernel_code(std::istreambuf_iterator<char>(kernel_file), (std::istreambuf_iterator<char>()));
+// --- Mode Atlas Julia ---
+// Grid cols x rows konstanta c di rentang [c_min_re, c_max_re] x [c_min_im, c_max_im] dirender dalam
+// satu peluncuran. Output: <prefix>.png (grid thumbnail) dan <prefix>.csv (statistik per thumbnail).
+struct AtlasConfig {
+    int cols = 16, rows = 16;
+    int thumb_w = 128, thumb_h = 128;
+    float c_min_re = -2.0f, c_max_re = 0.5f, c_min_im = -1.25f, c_max_im = 1.25f;
+    int max_iterations = MAX_ITERATIONS;
+    std::string output_prefix = "julia_atlas";
+};
 
-        cl::Program program(context, kernel_code);
-        try {
-            program.build({device});
-        } catch (const cl::Error& e) {
-            if (e.err() == CL_BUILD_PROGRAM_FAILURE) {
-                std::cerr << "=== OpenCL Build Log ===\n" << program.getBuildInfo<CL_PROGRAM_BUILD_LOG>(device) << "\n";
-            }
-            throw;
-        }
+// Estimasi keterhubungan: himpunan Julia terhubung jika orbit titik kritis 0 tetap terbatas.
+bool critical_orbit_bounded(std::complex<float> c, int max_iterations) {
+    return escape_iterations({0.0f, 0.0f}, c, max_iterations) == max_iterations;
+}
 
-        cl::Buffer output_buffer(context, CL_MEM_WRITE_ONLY, sizeof(int) * width * height);
-        cl::Kernel kernel(program, "generate_fractal");
-        kernel.setArg(0, output_buffer); kernel.setArg(1, width); kernel.setArg(2, height);
-        kernel.setArg(3, min_re); kernel.setArg(4, max_re); kernel.setArg(5, min_im); kernel.setArg(6, max_im);
-        kernel.setArg(7, MAX_ITERATIONS); kernel.setArg(8, static_cast<int>(is_julia));
-        kernel.setArg(9, julia_c.real()); kernel.setArg(10, julia_c.imag());
+void run_julia_atlas(const AtlasConfig& cfg) {
+    const int count = cfg.cols * cfg.rows;
+    const int tw = cfg.thumb_w, th = cfg.thumb_h;
+    std::cout << "Atlas Julia: " << cfg.cols << "x" << cfg.rows << " konstanta, thumbnail " << tw << "x" << th << "\n";
 
-        queue.enqueueNDRangeKernel(kernel, cl::NullRange, cl::NDRange(width * height), cl::NullRange);
+    std::vector<std::complex<float>> constants(count);
+    for (int j = 0; j < cfg.rows; ++j)
+        for (int i = 0; i < cfg.cols; ++i)
+            constants[j * cfg.cols + i] = {
+                cfg.c_min_re + (cfg.cols > 1 ? static_cast<float>(i) / (cfg.cols - 1) : 0.5f) * (cfg.c_max_re - cfg.c_min_re),
+                cfg.c_min_im + (cfg.rows > 1 ? static_cast<float>(j) / (cfg.rows - 1) : 0.5f) * (cfg.c_max_im - cfg.c_min_im)};
 
-        std::vector<int> iteration_results(width * height);
-        queue.enqueueReadBuffer(output_buffer, CL_TRUE, 0, sizeof(int) * width * height, iteration_results.data());
-        queue.finish();
+    float min_re = -1.6f, max_re = 1.6f;
+    float min_im = -1.6f * th / tw, max_im = 1.6f * th / tw;
 
-        #pragma omp parallel for
-        for (int i = 0; i < width * height; ++i) {
-            Color color = map_iteration_to_color(iteration_results[i]);
-            pixels[i * 3] = color.r; pixels[i * 3 + 1] = color.g; pixels[i * 3 + 2] = color.b;
-        }
+    std::vector<int> iterations(static_cast<size_t>(count) * tw * th);
+    std::string backend = "openmp";
+    auto start = std::chrono::steady_clock::now();
+    bool done = false;
+    #ifdef ENABLE_OPENCL
+    try {
+        OpenCLContext ctx;
+        init_opencl_context(ctx);
+        start = std::chrono::steady_clock::now(); // setup OpenCL tidak ikut dihitung
+        generate_julia_atlas_gpu(ctx, iterations, tw, th, constants, min_re, max_re, min_im, max_im, cfg.max_iterations);
+        backend = "opencl";
+        done = true;
     } catch (const cl::Error& e) {
-        std::cerr << "OpenCL Error: " << e.what() << " (" << e.err() << ")\n";
+        std::cerr << "OpenCL Error: " << e.what() << " (" << e.err() << "), memakai OpenMP\n";
     } catch (const std::runtime_error& e) {
-        std::cerr << "Runtime Error: " << e.what() << '\n';
+        std::cerr << "Runtime Error: " << e.what() << ", memakai OpenMP\n";
+    }
+    #endif
+    if (!done) {
+        start = std::chrono::steady_clock::now();
+        generate_julia_atlas_parallel(iterations, tw, th, constants, min_re, max_re, min_im, max_im, cfg.max_iterations);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double render_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    // Susun grid gambar dan statistik per thumbnail
+    const int atlas_w = cfg.cols * tw, atlas_h = cfg.rows * th;
+    std::vector<uint8_t> pixels(static_cast<size_t>(atlas_w) * atlas_h * 3);
+    std::vector<double> mean_iterations(count), interior_fraction(count);
+    #pragma omp parallel for schedule(dynamic)
+    for (int k = 0; k < count; ++k) {
+        int ox = (k % cfg.cols) * tw, oy = (k / cfg.cols) * th;
+        const int* thumb = &iterations[static_cast<size_t>(k) * tw * th];
+        long long sum = 0, interior = 0;
+        for (int py = 0; py < th; ++py) {
+            for (int px = 0; px < tw; ++px) {
+                int it = thumb[py * tw + px];
+                sum += it;
+                interior += (it == cfg.max_iterations);
+                Color color = map_iteration_to_color(it, cfg.max_iterations);
+                size_t index = (static_cast<size_t>(oy + py) * atlas_w + ox + px) * 3;
+                pixels[index] = color.r; pixels[index + 1] = color.g; pixels[index + 2] = color.b;
+            }
+        }
+        mean_iterations[k] = static_cast<double>(sum) / (tw * th);
+        interior_fraction[k] = static_cast<double>(interior) / (tw * th);
     }
+
+    std::string png_path = cfg.output_prefix + ".png", csv_path = cfg.output_prefix + ".csv";
+    stbi_write_png(png_path.c_str(), atlas_w, atlas_h, 3, pixels.data(), atlas_w * 3);
+
+    std::ofstream csv(csv_path);
+    csv << "index,col,row,c_re,c_im,connected,interior_fraction,mean_iterations\n";
+    csv << std::setprecision(7);
+    for (int k = 0; k < count; ++k) {
+        csv << k << ',' << k % cfg.cols << ',' << k / cfg.cols << ',' << constants[k].real() << ',' << constants[k].imag()
+            << ',' << (critical_orbit_bounded(constants[k], cfg.max_iterations) ? 1 : 0) << ',' << interior_fraction[k]
+            << ',' << mean_iterations[k] << '\n';
+    }
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "Backend: " << backend << ", waktu render: " << render_ms << " ms ("
+              << (render_ms > 0 ? count / (render_ms * 1e-3) : 0.0) << " thumbnail/s)\n"
+              << "Output: " << png_path << ", " << csv_path << "\n";
 }
-#endif
 
-// =======================================================================================
-// MODE OPERASI PROGRAM
-// =======================================================================================
+// --- Mode Buddhabrot ---
+void run_buddhabrot(int width, int height, long long samples, bool anti) {
+    const char* name = anti ? "Anti-Buddhabrot" : "Buddhabrot";
+    std::cout << name << ": " << width << "x" << height << ", sampel: " << samples
+              << ", thread: " << omp_get_max_threads() << "\n";
 
-// --- FUNGSI BARU: Mode Benchmark ---
-void run_benchmarks(int width, int height) {
-    std::cout << "=================================================\n";
-    std::cout << "            MODE BENCHMARK AKTIF\n";
-    std::cout << "=================================================\n";
-    std::cout << "Resolusi: " << width << "x" << height << ", Iterasi Maks: " << MAX_ITERATIONS << "\n\n";
-
-    std::vector<uint8_t> pixels(width * height * 3);
-    float min_re = -2.0f, max_re = 1.0f, min_im = -1.2f;
-    float max_im = min_im + (max_re - min_re) * static_cast<float>(height) / width;
-
-    // 1. Benchmark Serial
-    std::cout << "[1] Menjalankan benchmark Serial..." << std::flush;
-    auto start_serial = std::chrono::high_resolution_clock::now();
-    generate_fractal_serial(pixels, width, height, min_re, max_re, min_im, max_im);
-    auto end_serial = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double, std::milli> serial_time = end_serial - start_serial;
-    stbi_write_png("fractal_serial.png", width, height, 3, pixels.data(), width * 3);
-    std::cout << " Selesai.\n";
-
-    // 2. Benchmark Paralel (OpenMP)
-    std::cout << "[2] Menjalankan benchmark Paralel (OpenMP)..." << std::flush;
-    auto start_parallel = std::chrono::high_resolution_clock::now();
-    generate_fractal_parallel(pixels, width, height, min_re, max_re, min_im, max_im);
-    auto end_parallel = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double, std::milli> parallel_time = end_parallel - start_parallel;
-    stbi_write_png("fractal_parallel_omp.png", width, height, 3, pixels.data(), width * 3);
-    std::cout << " Selesai.\n";
-
-    // 3. Benchmark GPU (OpenCL)
-    #ifdef ENABLE_OPENCL
-    std::cout << "[3] Menjalankan benchmark GPU (OpenCL)..." << std::flush;
-    auto start_gpu = std::chrono::high_resolution_clock::now();
-    generate_fractal_gpu(pixels, width, height, min_re, max_re, min_im, max_im, false, {0,0});
-    auto end_gpu = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double, std::milli> gpu_time = end_gpu - start_gpu;
-    stbi_write_png("fractal_gpu_opencl.png", width, height, 3, pixels.data(), width * 3);
-    std::cout << " Selesai.\n";
-    #endif
+    float min_re = -2.0f, max_re = 1.0f;
+    float im_half = (max_re - min_re) * static_cast<float>(height) / width * 0.5f;
+    float min_im = -im_half, max_im = im_half;
 
-    // 4. Tampilkan Hasil
-    std::cout << "\n================  HASIL BENCHMARK  ================\n";
-    std::cout << "Waktu Eksekusi Serial           : " << std::fixed << std::setprecision(2) << serial_time.count() << " ms\n";
-    std::cout << "Waktu Eksekusi Paralel (OpenMP) : " << parallel_time.count() << " ms\n";
-    #ifdef ENABLE_OPENCL
-    std::cout << "Waktu Eksekusi GPU (OpenCL)     : " << gpu_time.count() << " ms\n";
-    #endif
-    std::cout << "-------------------------------------------------\n";
-    std::cout << "Rasio Percepatan (OpenMP vs Serial) : " << (serial_time.count() / parallel_time.count()) << "x\n";
-    #ifdef ENABLE_OPENCL
-    std::cout << "Rasio Percepatan (OpenCL vs Serial) : " << (serial_time.count() / gpu_time.count()) << "x\n";
-    #endif
-    std::cout << "=================================================\n";
-    std::cout << "Gambar output: fractal_serial.png, fractal_parallel_omp.png, fractal_gpu_opencl.png\n";
+    std::vector<uint32_t> histogram(static_cast<size_t>(width) * height);
+    BuddhabrotStats stats;
+    auto start = std::chrono::steady_clock::now();
+    generate_buddhabrot(histogram, width, height, min_re, max_re, min_im, max_im, samples, anti,
+                        static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count()), stats);
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    // Tone mapping akar kuadrat terhadap kepadatan maksimum
+    uint32_t max_count = 1;
+    for (uint32_t v : histogram) max_count = std::max(max_count, v);
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 3);
+    #pragma omp parallel for
+    for (long long i = 0; i < static_cast<long long>(histogram.size()); ++i) {
+        float t = std::sqrt(static_cast<float>(histogram[i]) / max_count);
+        pixels[i * 3]     = static_cast<uint8_t>(255 * std::min(1.0f, t * 1.2f));
+        pixels[i * 3 + 1] = static_cast<uint8_t>(255 * t);
+        pixels[i * 3 + 2] = static_cast<uint8_t>(255 * std::min(1.0f, t * t * 1.5f));
+    }
+    std::string out_path = anti ? "anti_buddhabrot.png" : "buddhabrot.png";
+    stbi_write_png(out_path.c_str(), width, height, 3, pixels.data(), width * 3);
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "Waktu: " << seconds * 1e3 << " ms, " << stats.samples / seconds / 1e6 << " Msampel/s ("
+              << stats.samples / seconds / 1e6 / omp_get_max_threads() << " per thread)\n"
+              << "Ditolak awal (kardioid/bulb): " << stats.rejected << ", orbit diakumulasi: " << stats.accepted_orbits
+              << ", kunjungan: " << stats.orbit_points << "\n"
+              << "Output: " << out_path << "\n";
 }
 
 // --- Mode GUI Interaktif ---
 #ifdef ENABLE_SFML_GUI
-void run_interactive_gui(int width, int height) {
+// Overlay HUD: satu bar per tahap frame terakhir (skala 50 ms = 300 px), ditambah teks jika font tersedia.
+void draw_profiler_hud(sf::RenderWindow& window, const FrameStats& stats, const sf::Font* font) {
+    const sf::Color stage_colors[] = {
+        sf::Color(230, 90, 90), sf::Color(90, 200, 90), sf::Color(90, 140, 230),
+        sf::Color(230, 200, 80), sf::Color(200, 90, 220), sf::Color(80, 210, 210)
+    };
+    const float px_per_ms = 6.0f, row_h = 16.0f;
+    int rows = static_cast<int>(stats.stages.size()) + 2;
+
+    sf::RectangleShape background({420.f, rows * row_h + 12.f});
+    background.setPosition(8.f, 8.f);
+    background.setFillColor(sf::Color(0, 0, 0, 170));
+    window.draw(background);
+
+    std::stringstream summary;
+    summary << std::fixed << std::setprecision(1) << "frame " << stats.frame_ms << " ms  |  "
+            << std::setprecision(0) << stats.iterations_per_sec() / 1e6 << " Miter/s  |  esc "
+            << stats.escaped << " / int " << stats.interior;
+
+    std::stringstream busy;
+    busy << std::fixed << std::setprecision(1) << "busy/thread ms:";
+    for (double ms : stats.thread_busy_ms) busy << " " << ms;
+
+    float y = 14.f;
+    auto draw_text = [&](const std::string& str, float x, float ty) {
+        if (!font) return;
+        sf::Text text(str, *font, 12);
+        text.setPosition(x, ty);
+        text.setFillColor(sf::Color::White);
+        window.draw(text);
+    };
+    draw_text(summary.str(), 14.f, y); y += row_h;
+    draw_text(busy.str(), 14.f, y); y += row_h;
+
+    for (size_t i = 0; i < stats.stages.size(); ++i) {
+        sf::RectangleShape bar({std::min(300.f, static_cast<float>(stats.stages[i].second) * px_per_ms) + 1.f, row_h - 4.f});
+        bar.setPosition(120.f, y + 2.f);
+        bar.setFillColor(stage_colors[i % (sizeof(stage_colors) / sizeof(stage_colors[0]))]);
+        window.draw(bar);
+        std::stringstream label;
+        label << std::fixed << std::setprecision(2) << stats.stages[i].first << " " << stats.stages[i].second;
+        draw_text(label.str(), 14.f, y);
+        y += row_h;
+    }
+}
+
+bool load_hud_font(sf::Font& font) {
+    const char* candidates[] = {
+        "/usr/share/fonts/truetype/dejavu/DejaVuSansMono.ttf",
+        "/usr/share/fonts/TTF/DejaVuSansMono.ttf",
+        "/usr/share/fonts/dejavu/DejaVuSansMono.ttf",
+        "C:/Windows/Fonts/consola.ttf",
+    };
+    for (const char* path : candidates) {
+        if (std::ifstream(path).good() && font.loadFromFile(path)) return true;
+    }
+    return false;
+}
+
+// Event SFML diterjemahkan ke InputEvent lalu diproses oleh apply_input (gui_replay.hpp), sehingga
+// sesi yang direkam dengan --record bisa diputar ulang tanpa window dengan --replay.
+bool translate_sfml_event(const sf::Event& event, double t_ms, InputEvent& out) {
+    out = InputEvent();
+    out.t_ms = t_ms;
+    switch (event.type) {
+        case sf::Event::Closed: out.kind = InputKind::Close; return true;
+        case sf::Event::KeyPressed:
+            if (event.key.code < sf::Keyboard::A || event.key.code > sf::Keyboard::Z) return false;
+            out.kind = InputKind::Key;
+            out.key = static_cast<char>('A' + (event.key.code - sf::Keyboard::A));
+            return true;
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+            if (event.mouseButton.button != sf::Mouse::Left && event.mouseButton.button != sf::Mouse::Right) return false;
+            out.kind = (event.type == sf::Event::MouseButtonPressed) ? InputKind::MouseDown : InputKind::MouseUp;
+            out.button = (event.mouseButton.button == sf::Mouse::Left) ? 'L' : 'R';
+            out.x = event.mouseButton.x; out.y = event.mouseButton.y;
+            return true;
+        case sf::Event::MouseMoved:
+            out.kind = InputKind::MouseMove;
+            out.x = event.mouseMove.x; out.y = event.mouseMove.y;
+            return true;
+        case sf::Event::MouseWheelScrolled:
+            if (event.mouseWheelScroll.wheel != sf::Mouse::VerticalWheel || event.mouseWheelScroll.delta == 0) return false;
+            out.kind = InputKind::Wheel;
+            out.wheel = event.mouseWheelScroll.delta > 0 ? 1 : -1; // satu langkah 2x per notch
+            out.x = event.mouseWheelScroll.x; out.y = event.mouseWheelScroll.y;
+            return true;
+        default: return false;
+    }
+}
+
+void run_interactive_gui(int width, int height, const std::string& record_path) {
     sf::RenderWindow window(sf::VideoMode(width, height), "Interactive Fractal Explorer | Gemini");
     window.setFramerateLimit(60);
 
@@ -269,181 +619,597 @@ void run_interactive_gui(int width, int height) {
     sf::Texture texture; sf::Sprite sprite;
 
     std::vector<uint8_t> pixels(width * height * 4);
+    std::vector<uint8_t> temp_pixels(width * height * 3);
+
+    // Backend dipilih per frame dari model biaya (profil dimuat atau dikalibrasi saat start)
+    Renderer renderer;
+    BackendSelector selector;
+    selector.load_or_calibrate(renderer);
+    BackendChoice last_choice;
+    RenderResult last_result;
+    IterationCache zoom_cache; // buffer iterasi frame terakhir untuk zoom roda
+    JuliaInset inset(width, height);
+    sf::Texture inset_texture; sf::Sprite inset_sprite;
+    sf::RectangleShape inset_frame({static_cast<float>(inset.display_w), static_cast<float>(inset.display_h)});
+    inset_frame.setPosition(static_cast<float>(width - inset.display_w - 10), static_cast<float>(height - inset.display_h - 10));
+    inset_frame.setFillColor(sf::Color::Transparent);
+    inset_frame.setOutlineColor(sf::Color::White);
+    inset_frame.setOutlineThickness(1.f);
+    ReuseStats last_reuse;
+    bool last_was_reuse = false;
+
+    ViewState view(width, height);
 
-    float min_re = -2.0f, max_re = 1.0f;
-    float min_im = -1.2f, max_im = min_im + (max_re - min_re) * static_cast<float>(height) / width;
-    bool needs_redraw = true;
-    bool is_julia = false;
-    std::complex<float> julia_c(-0.7f, 0.27015f);
-    bool julia_locked = false;
-
-    bool is_zooming = false;
-    sf::Vector2f zoom_start_pos;
     sf::RectangleShape zoom_rect;
     zoom_rect.setFillColor(sf::Color(100, 100, 255, 50));
     zoom_rect.setOutlineColor(sf::Color::White);
     zoom_rect.setOutlineThickness(1.f);
 
-    bool rightDragging = false;
-    sf::Vector2i lastMousePos;
+    sf::Font hud_font;
+    bool hud_font_loaded = load_hud_font(hud_font);
+
+    InputRecorder recorder;
+    if (!record_path.empty()) {
+        if (recorder.open(record_path, width, height)) std::cout << "Merekam event ke " << record_path << "\n";
+        else std::cerr << "Error: Gagal membuka " << record_path << " untuk merekam\n";
+    }
+    const auto session_start = std::chrono::steady_clock::now();
 
     std::cout << "\nEntering Interactive Mode (" << width << "x" << height << ")...\n"
               << "---------------------------\n"
               << "Controls:\n"
               << "  - Left Click + Drag : Zoom to area\n"
               << "  - Right Click + Drag: Pan image\n"
+              << "  - Mouse Wheel       : Zoom in/out 2x (reuses computed samples)\n"
               << "  - 'J' Key           : Toggle Mandelbrot/Julia set\n"
-              << "  - 'L' Key           : Lock/Unlock Julia set constant 'c'\n"
+              << "  - 'L' Key           : Lock/Unlock Julia set constant 'c' (Split View: render inset Julia in full)\n"
+              << "  - 'V' Key           : Toggle Split View (cached Mandelbrot + live Julia inset)\n"
               << "  - 'S' Key           : Save current view to PNG file\n"
               << "  - 'R' Key           : Reset view\n"
+              << "  - 'H' Key           : Toggle profiling HUD\n"
               << "  - Mouse Move        : (Julia Mode) Change 'c' constant\n"
               << "---------------------------\n\n";
 
     while (window.isOpen()) {
         sf::Event event;
         while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) window.close();
+            InputEvent input;
+            double t_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - session_start).count();
+            if (!translate_sfml_event(event, t_ms, input)) continue;
+            recorder.record(input);
+            InputEffects fx = apply_input(view, input);
 
-            if (event.type == sf::Event::KeyPressed) {
-                if (event.key.code == sf::Keyboard::J) {
-                    is_julia = !is_julia; needs_redraw = true;
-                    std::cout << "Mode switched to: " << (is_julia ? "Julia" : "Mandelbrot") << std::endl;
-                }
-                if (event.key.code == sf::Keyboard::R) {
-                    min_re = -2.0f; max_re = 1.0f;
-                    min_im = -1.2f; max_im = min_im + (max_re - min_re) * static_cast<float>(height) / width;
-                    needs_redraw = true;
-                }
-                if (event.key.code == sf::Keyboard::S) {
-                    auto now = std::chrono::system_clock::now();
-                    std::time_t now_time = std::chrono::system_clock::to_time_t(now);
-                    std::stringstream ss;
-                    ss << "fractal_" << std::put_time(std::localtime(&now_time), "%Y-%m-%d_%H-%M-%S") << ".png";
-                    if (image.saveToFile(ss.str())) std::cout << "Image saved to " << ss.str() << std::endl;
-                    else std::cerr << "Error: Failed to save image to " << ss.str() << std::endl;
-                }
-                if (event.key.code == sf::Keyboard::L) {
-                    if (is_julia) {
-                        julia_locked = !julia_locked;
-                        std::cout << "Julia set constant 'c' is now " << (julia_locked ? "LOCKED" : "UNLOCKED") << std::endl;
-                        std::string title = "Interactive Fractal Explorer | Julia Set";
-                        if(julia_locked) title += " (Locked)";
-                        window.setTitle(title);
-                    }
-                }
+            if (fx.close_requested) window.close();
+            if (fx.mode_changed) std::cout << "Mode switched to: " << (view.is_julia ? "Julia" : "Mandelbrot") << std::endl;
+            if (fx.save_requested) {
+                auto now = std::chrono::system_clock::now();
+                std::time_t now_time = std::chrono::system_clock::to_time_t(now);
+                std::stringstream ss;
+                ss << "fractal_" << std::put_time(std::localtime(&now_time), "%Y-%m-%d_%H-%M-%S") << ".png";
+                if (image.saveToFile(ss.str())) std::cout << "Image saved to " << ss.str() << std::endl;
+                else std::cerr << "Error: Failed to save image to " << ss.str() << std::endl;
             }
-
-            if (event.type == sf::Event::MouseButtonPressed) {
-                if (event.mouseButton.button == sf::Mouse::Left) {
-                    is_zooming = true;
-                    zoom_start_pos = window.mapPixelToCoords({event.mouseButton.x, event.mouseButton.y});
-                } else if (event.mouseButton.button == sf::Mouse::Right) {
-                    rightDragging = true;
-                    lastMousePos = {event.mouseButton.x, event.mouseButton.y};
-                }
+            if (fx.hud_toggled) g_profiler.enabled = view.show_hud || g_profiler.record_trace;
+            if (fx.split_changed) {
+                std::cout << "Split View " << (view.split_view ? "ON" : "OFF") << std::endl;
+                if (view.split_view) window.setTitle("Interactive Fractal Explorer | Split View");
+                else if (!fx.lock_changed) window.setTitle("Interactive Fractal Explorer | Gemini");
             }
-            if (event.type == sf::Event::MouseButtonReleased) {
-                if (event.mouseButton.button == sf::Mouse::Left && is_zooming) {
-                    is_zooming = false;
-                    sf::Vector2f zoom_end_pos = window.mapPixelToCoords({event.mouseButton.x, event.mouseButton.y});
-                    if (zoom_start_pos.x != zoom_end_pos.x && zoom_start_pos.y != zoom_end_pos.y) {
-                        float re_range = max_re - min_re;
-                        float new_min_re = min_re + (std::min(zoom_start_pos.x, zoom_end_pos.x) / width) * re_range;
-                        float new_max_re = min_re + (std::max(zoom_start_pos.x, zoom_end_pos.x) / width) * re_range;
-                        float new_min_im = min_im + (std::min(zoom_start_pos.y, zoom_end_pos.y) / height) * (max_im - min_im);
-                        max_im = new_min_im + (new_max_re - new_min_re) * static_cast<float>(height) / width;
-                        min_re = new_min_re; max_re = new_max_re; min_im = new_min_im;
-                        needs_redraw = true;
-                    }
-                } else if (event.mouseButton.button == sf::Mouse::Right) rightDragging = false;
+            if (fx.lock_changed) {
+                std::cout << "Julia set constant 'c' is now " << (view.julia_locked ? "LOCKED" : "UNLOCKED") << std::endl;
+                std::string title = "Interactive Fractal Explorer | Julia Set";
+                if(view.julia_locked) title += " (Locked)";
+                window.setTitle(title);
             }
-            // ===== BLOK BARU YANG SUDAH DIPERBAIKI =====
-            if (event.type == sf::Event::MouseMoved) {
-                sf::Vector2i currentMousePos(event.mouseMove.x, event.mouseMove.y);
-
-                // --- Logika untuk menggambar persegi panjang zoom ---
-                if (is_zooming) {
-                    // Konversi posisi mouse saat ini ke koordinat dunia/view
-                    sf::Vector2f currentWorldPos = window.mapPixelToCoords(currentMousePos);
-
-                    // Tentukan pojok kiri-atas dan ukuran persegi secara dinamis
-                    // agar berfungsi ke segala arah drag
-                    float left = std::min(zoom_start_pos.x, currentWorldPos.x);
-                    float top = std::min(zoom_start_pos.y, currentWorldPos.y);
-                    float width = std::abs(zoom_start_pos.x - currentWorldPos.x);
-                    float height = std::abs(zoom_start_pos.y - currentWorldPos.y);
-
-                    // Atur posisi dan ukuran persegi panjang zoom
-                    zoom_rect.setPosition(left, top);
-                    zoom_rect.setSize({width, height});
-                }
-
-                // --- Logika untuk Pan/Geser (klik kanan) ---
-                if (rightDragging) {
-                    sf::Vector2i delta = currentMousePos - lastMousePos;
-                    float dx = -static_cast<float>(delta.x) * (max_re - min_re) / width;
-                    float dy = -static_cast<float>(delta.y) * (max_im - min_im) / height;
-                    min_re += dx; max_re += dx; min_im += dy; max_im += dy;
-                    needs_redraw = true;
-                    lastMousePos = currentMousePos;
-                }
+        }
 
-                // --- Logika untuk update konstanta Julia ---
-                if (is_julia && !julia_locked) {
-                    julia_c.real(min_re + (static_cast<float>(currentMousePos.x) / width) * (max_re - min_re));
-                    julia_c.imag(min_im + (static_cast<float>(currentMousePos.y) / height) * (max_im - min_im));
-                    needs_redraw = true;
-                }
-            }
+        // Persegi zoom mengikuti drag ke segala arah
+        if (view.is_zooming) {
+            float cur_x = static_cast<float>(view.mouse_x), cur_y = static_cast<float>(view.mouse_y);
+            zoom_rect.setPosition(std::min(view.zoom_start_x, cur_x), std::min(view.zoom_start_y, cur_y));
+            zoom_rect.setSize({std::abs(view.zoom_start_x - cur_x), std::abs(view.zoom_start_y - cur_y)});
         }
 
-        if (needs_redraw) {
+        bool frame_rendered = false;
+        double render_ms = 0.0;
+        if (view.needs_redraw) {
             std::cout << "Rendering... " << std::flush;
+            g_profiler.begin_frame();
             auto start_render = std::chrono::high_resolution_clock::now();
-            std::vector<uint8_t> temp_pixels(width * height * 3);
-            #ifdef ENABLE_OPENCL
-            generate_fractal_gpu(temp_pixels, width, height, min_re, max_re, min_im, max_im, is_julia, julia_c);
-            #else
-            generate_fractal_parallel(temp_pixels, width, height, min_re, max_re, min_im, max_im, is_julia, julia_c);
-            #endif
-            for(int i = 0; i < width * height; ++i) {
-                pixels[i*4 + 0] = temp_pixels[i*3 + 0]; pixels[i*4 + 1] = temp_pixels[i*3 + 1];
-                pixels[i*4 + 2] = temp_pixels[i*3 + 2]; pixels[i*4 + 3] = 255;
+            last_was_reuse = view.grid_step;
+            if (view.grid_step) {
+                last_reuse = render_view_reuse(zoom_cache, view, temp_pixels, pixels);
+            } else {
+                last_result = render_view_auto(renderer, selector, view, temp_pixels, pixels, &last_choice, &zoom_cache);
+            }
+            view.grid_step = false;
+            {
+                PROFILE_SCOPE("texture_upload");
+                image.create(width, height, pixels.data());
+                texture.loadFromImage(image);
+                sprite.setTexture(texture);
             }
-            image.create(width, height, pixels.data());
-            texture.loadFromImage(image);
-            sprite.setTexture(texture);
             auto end_render = std::chrono::high_resolution_clock::now();
             std::chrono::duration<double, std::milli> render_time = end_render - start_render;
-            std::cout << "Done in " << render_time.count() << " ms." << std::endl;
-            needs_redraw = false;
+            render_ms = render_time.count();
+            view.needs_redraw = false;
+            frame_rendered = true;
+        }
+
+        // Inset Julia: hanya inset yang dirender saat mouse bergerak, base tetap dari tekstur
+        if (view.split_view && view.inset_dirty) {
+            if (!frame_rendered) g_profiler.begin_frame();
+            render_julia_inset(inset, view);
+            {
+                PROFILE_SCOPE("texture_upload");
+                if (inset_texture.getSize().x != static_cast<unsigned>(inset.render_w) ||
+                    inset_texture.getSize().y != static_cast<unsigned>(inset.render_h))
+                    inset_texture.create(inset.render_w, inset.render_h);
+                inset_texture.update(inset.rgba.data());
+                inset_sprite.setTexture(inset_texture, true);
+                inset_sprite.setScale(static_cast<float>(inset.display_w) / inset.render_w,
+                                      static_cast<float>(inset.display_h) / inset.render_h);
+                inset_sprite.setPosition(inset_frame.getPosition());
+            }
+            if (!frame_rendered) g_profiler.end_frame();
+            view.inset_dirty = false;
+        }
+
+        window.clear();
+        window.draw(sprite);
+        if (view.split_view) { window.draw(inset_sprite); window.draw(inset_frame); }
+        if(view.is_zooming) window.draw(zoom_rect);
+        if(view.show_hud) draw_profiler_hud(window, g_profiler.last_frame, hud_font_loaded ? &hud_font : nullptr);
+        {
+            PROFILE_SCOPE("present");
+            window.display();
+        }
+
+        if (frame_rendered) {
+            g_profiler.end_frame();
+            std::cout << "Done in " << render_ms << " ms. [";
+            if (last_was_reuse)
+                std::cout << "zoom 2^" << last_reuse.scale_log2 << ", dipakai ulang " << last_reuse.reused << " / dihitung "
+                          << last_reuse.computed << " piksel" << (last_reuse.aligned ? "" : " (cache tidak sejajar)");
+            else
+                std::cout << selector.describe(last_choice, last_result);
+            std::cout << "]";
+            if (g_profiler.enabled) {
+                const FrameStats& st = g_profiler.last_frame;
+                std::cout << " [";
+                for (size_t i = 0; i < st.stages.size(); ++i)
+                    std::cout << (i ? ", " : "") << st.stages[i].first << " " << st.stages[i].second << " ms";
+                std::cout << "; " << st.iterations_per_sec() / 1e6 << " Miter/s]";
+            }
+            std::cout << std::endl;
+        }
+    }
+    if (!selector.save()) std::cerr << "Error: Gagal menulis profil backend " << selector.path() << "\n";
+}
+#endif
+
+#ifdef ENABLE_SFML_GUI
+// --- Viewer Streaming ---
+// Window ringan: semua render terjadi di --stream-server. ViewState lokal hanya dipakai untuk
+// menggambar persegi zoom selama drag (frame tetap berasal dari server).
+void run_stream_viewer(const std::string& host, int port) {
+    StreamClient client;
+    if (!client.connect(host, port)) {
+        std::cerr << "Error: Gagal terhubung ke stream server " << host << ":" << port << "\n";
+        return;
+    }
+    const int width = client.width(), height = client.height();
+    sf::RenderWindow window(sf::VideoMode(width, height), "Fractal Stream Viewer | " + host + ":" + std::to_string(port));
+    window.setFramerateLimit(60);
+    sf::Texture texture; texture.create(width, height);
+    sf::Sprite sprite(texture);
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    ViewState local(width, height);
+    sf::RectangleShape zoom_rect;
+    zoom_rect.setFillColor(sf::Color(100, 100, 255, 50));
+    zoom_rect.setOutlineColor(sf::Color::White);
+    zoom_rect.setOutlineThickness(1.f);
+    std::cout << "Terhubung ke " << host << ":" << port << " (" << width << "x" << height << ")" << std::endl;
+
+    const auto session_start = std::chrono::steady_clock::now();
+    bool connected = true;
+    while (window.isOpen() && connected) {
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            InputEvent input;
+            double t_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - session_start).count();
+            if (!translate_sfml_event(event, t_ms, input)) continue;
+            apply_input(local, input);
+            if (!client.send_input(input)) connected = false;
+            if (input.kind == InputKind::Close) window.close();
         }
 
+        // Terapkan semua frame yang sudah tiba, unggah tekstur sekali
+        bool updated = false;
+        int r;
+        while ((r = client.poll_frame(0)) == 1) updated = updated || !client.last_was_ack();
+        if (r < 0) connected = false;
+        if (updated) {
+            const std::vector<uint8_t>& rgb = client.rgb();
+            for (int i = 0; i < width * height; ++i) {
+                rgba[i*4 + 0] = rgb[i*3 + 0]; rgba[i*4 + 1] = rgb[i*3 + 1];
+                rgba[i*4 + 2] = rgb[i*3 + 2]; rgba[i*4 + 3] = 255;
+            }
+            texture.update(rgba.data());
+        }
+        if (local.is_zooming) {
+            float cur_x = static_cast<float>(local.mouse_x), cur_y = static_cast<float>(local.mouse_y);
+            zoom_rect.setPosition(std::min(local.zoom_start_x, cur_x), std::min(local.zoom_start_y, cur_y));
+            zoom_rect.setSize({std::abs(local.zoom_start_x - cur_x), std::abs(local.zoom_start_y - cur_y)});
+        }
         window.clear();
         window.draw(sprite);
-        if(is_zooming) window.draw(zoom_rect);
+        if (local.is_zooming) window.draw(zoom_rect);
         window.display();
     }
+    client.close();
+
+    const StreamClientStats& st = client.stats;
+    std::vector<double> lat = st.latencies;
+    std::sort(lat.begin(), lat.end());
+    std::cout << std::fixed << std::setprecision(2) << "Stream selesai: " << st.frames << " frame, "
+              << st.bytes / 1024.0 << " KiB (" << (st.frames ? st.bytes / 1024.0 / st.frames : 0.0) << " KiB/frame)";
+    if (!lat.empty()) std::cout << ", latensi input->frame p50 " << lat[lat.size() / 2] << " ms, max " << lat.back() << " ms";
+    std::cout << std::endl;
 }
 #endif
 
 // --- Fungsi Main dengan Pemilihan Mode ---
 int main(int argc, char* argv[]) {
     bool benchmark_mode = false;
+    bool atlas_mode = false;
+    int buddhabrot_mode = 0; // 1 = Buddhabrot, 2 = Anti-Buddhabrot
+    long long buddhabrot_samples = 0;
+    bool serve_mode = false, loadgen_mode = false;
+    TileServerConfig server_config;
+    LoadGenConfig loadgen_config;
+    bool coordinator_mode = false, worker_mode = false;
+    CoordinatorConfig coordinator_config;
+    WorkerConfig worker_config;
+    bool field_mode = false, colorize_field_mode = false;
+    FieldRenderConfig field_config;
+    FieldColorizeConfig colorize_config;
+    bool checkpoint_mode = false, checkpoint_status_mode = false;
+    CheckpointConfig checkpoint_config;
+    bool replay_mode = false;
+    ReplayConfig replay_config;
+    std::string record_path;
+    bool stream_server_mode = false, stream_view_mode = false, stream_bench_mode = false;
+    StreamServerConfig stream_config;
+    StreamBenchConfig stream_bench_config;
+    std::string stream_host = "127.0.0.1";
+    bool calibrate_mode = false;
+    std::string profile_path = DEFAULT_BACKEND_PROFILE;
+    bool expmap_mode = false;
+    ExpMapConfig expmap_config;
+    AtlasConfig atlas_config;
     int width = DEFAULT_WIDTH;
     int height = DEFAULT_HEIGHT;
+    BenchConfig bench_config;
+
+    // Opsi global --trace <file.json>: aktifkan instrumentasi dan tulis Chrome trace saat keluar
+    std::string trace_path;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--trace") {
+            trace_path = argv[i + 1];
+            for (int j = i; j + 2 < argc; ++j) argv[j] = argv[j + 2];
+            argc -= 2;
+            break;
+        }
+    }
+    // Opsi GUI --record <file>: rekam aliran event untuk diputar ulang dengan --replay
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--record") {
+            record_path = argv[i + 1];
+            for (int j = i; j + 2 < argc; ++j) argv[j] = argv[j + 2];
+            argc -= 2;
+            break;
+        }
+    }
+    if (!trace_path.empty()) {
+        g_profiler.enabled = true;
+        g_profiler.record_trace = true;
+    }
 
     // Parsing argumen command-line
     if (argc > 1) {
         std::string first_arg = argv[1];
         if (first_arg == "--benchmark") {
             benchmark_mode = true;
-            if (argc == 4) { // ./prog --benchmark 1920 1080
+            int i = 2;
+            if (argc >= 4 && argv[2][0] != '-') { // ./prog --benchmark 1920 1080 [opsi]
                 try {
                     width = std::stoi(argv[2]);
                     height = std::stoi(argv[3]);
                 } catch(...) { /* biarkan default jika parsing gagal */ }
+                i = 4;
+            }
+            for (; i < argc; i += 2) { // --reps N --warmup N --threads 1,2,4 --out prefix --pin P --numa
+                std::string opt = argv[i];
+                if (opt == "--numa") { bench_config.numa = true; --i; continue; }
+                if (i + 1 >= argc) { std::cerr << "Opsi " << opt << " membutuhkan nilai\n"; break; }
+                std::string val = argv[i + 1];
+                try {
+                    if (opt == "--reps") bench_config.repetitions = std::max(1, std::stoi(val));
+                    else if (opt == "--warmup") bench_config.warmup = std::max(0, std::stoi(val));
+                    else if (opt == "--out") bench_config.output_prefix = val;
+                    else if (opt == "--pin") {
+                        if (!parse_pin_policy(val, bench_config.pin)) std::cerr << "Kebijakan pin tidak dikenal: " << val << "\n";
+                    }
+                    else if (opt == "--threads") {
+                        std::stringstream list(val);
+                        std::string item;
+                        while (std::getline(list, item, ','))
+                            if (std::stoi(item) > 0) bench_config.thread_counts.push_back(std::stoi(item));
+                    }
+                    else std::cerr << "Opsi tidak dikenal: " << opt << "\n";
+                } catch(...) { std::cerr << "Nilai tidak valid untuk " << opt << "\n"; }
+            }
+        } else if (first_arg == "--atlas") {
+            // ./prog --atlas [cols rows [thumb_w thumb_h [c_min_re c_max_re c_min_im c_max_im]]] [--iter N]
+            atlas_mode = true;
+            try {
+                std::vector<std::string> pos;
+                for (int i = 2; i < argc; ++i) {
+                    std::string opt = argv[i];
+                    if (opt == "--iter" && i + 1 < argc) atlas_config.max_iterations = std::max(1, std::stoi(argv[++i]));
+                    else pos.push_back(opt);
+                }
+                if (pos.size() >= 2) { atlas_config.cols = std::max(1, std::stoi(pos[0])); atlas_config.rows = std::max(1, std::stoi(pos[1])); }
+                if (pos.size() >= 4) { atlas_config.thumb_w = std::max(2, std::stoi(pos[2])); atlas_config.thumb_h = std::max(2, std::stoi(pos[3])); }
+                if (pos.size() >= 8) {
+                    atlas_config.c_min_re = std::stof(pos[4]); atlas_config.c_max_re = std::stof(pos[5]);
+                    atlas_config.c_min_im = std::stof(pos[6]); atlas_config.c_max_im = std::stof(pos[7]);
+                }
+            } catch(...) { /* biarkan default jika parsing gagal */ }
+        } else if (first_arg == "--buddhabrot" || first_arg == "--anti-buddhabrot") {
+            // ./prog --buddhabrot [width height [samples]]
+            buddhabrot_mode = (first_arg == "--buddhabrot") ? 1 : 2;
+            try {
+                if (argc >= 4) { width = std::stoi(argv[2]); height = std::stoi(argv[3]); }
+                if (argc >= 5) buddhabrot_samples = std::stoll(argv[4]);
+            } catch(...) { /* biarkan default jika parsing gagal */ }
+        } else if (first_arg == "--serve") {
+            // ./prog --serve [port [serial|openmp|opencl]] [--tile N] [--iter N]
+            serve_mode = true;
+            std::vector<std::string> positional;
+            try {
+                for (int i = 2; i < argc; ++i) {
+                    std::string opt = argv[i];
+                    if (opt == "--tile" && i + 1 < argc) server_config.tile_size = std::max(8, std::stoi(argv[++i]));
+                    else if (opt == "--iter" && i + 1 < argc) server_config.max_iterations = std::max(1, std::stoi(argv[++i]));
+                    else if (opt[0] == '-') std::cerr << "Opsi tidak dikenal: " << opt << "\n";
+                    else positional.push_back(opt);
+                }
+                if (positional.size() >= 1) server_config.port = std::stoi(positional[0]);
+            } catch(...) { /* biarkan default jika parsing gagal */ }
+            if (positional.size() >= 2 && !parse_backend(positional[1], server_config.backend))
+                std::cerr << "Backend tidak dikenal: " << positional[1] << ", memakai openmp\n";
+        } else if (first_arg == "--loadgen") {
+            // ./prog --loadgen [host port [requests [concurrency [zoom]]]]
+            loadgen_mode = true;
+            try {
+                if (argc >= 4) { loadgen_config.host = argv[2]; loadgen_config.port = std::stoi(argv[3]); }
+                if (argc >= 5) loadgen_config.requests = std::stoi(argv[4]);
+                if (argc >= 6) loadgen_config.concurrency = std::max(1, std::stoi(argv[5]));
+                if (argc >= 7) loadgen_config.zoom = std::min(max_tile_zoom(TileServerConfig().tile_size), std::max(0, std::stoi(argv[6])));
+            } catch(...) { /* biarkan default jika parsing gagal */ }
+        } else if (first_arg == "--coordinator") {
+            // ./prog --coordinator [port [width height [frames [tile]]]] [--spawn N] [--out prefix] [--iter N] [--tile-timeout S]
+            coordinator_mode = true;
+            int i = 2;
+            std::vector<int> positional;
+            for (; i < argc && argv[i][0] != '-'; ++i) {
+                try { positional.push_back(std::stoi(argv[i])); } catch(...) { /* abaikan */ }
+            }
+            if (positional.size() >= 1) coordinator_config.port = positional[0];
+            if (positional.size() >= 3) { coordinator_config.width = std::max(2, positional[1]); coordinator_config.height = std::max(2, positional[2]); }
+            if (positional.size() >= 4) coordinator_config.frames = std::max(1, positional[3]);
+            if (positional.size() >= 5) coordinator_config.tile_size = std::max(2, positional[4]);
+            for (; i + 1 < argc; i += 2) {
+                std::string opt = argv[i];
+                if (opt == "--spawn") { try { coordinator_config.spawn_workers = std::stoi(argv[i + 1]); } catch(...) {} }
+                else if (opt == "--out") coordinator_config.output_prefix = argv[i + 1];
+                else if (opt == "--iter") { try { coordinator_config.max_iterations = std::max(1, std::stoi(argv[i + 1])); } catch(...) {} }
+                else if (opt == "--tile-timeout") { try { coordinator_config.tile_timeout = std::max(0.1, std::stod(argv[i + 1])); } catch(...) {} }
+                else std::cerr << "Opsi tidak dikenal: " << opt << "\n";
+            }
+        } else if (first_arg == "--worker") {
+            // ./prog --worker [host port [serial|openmp|opencl [die_after]]]
+            worker_mode = true;
+            try {
+                if (argc >= 4) { worker_config.host = argv[2]; worker_config.port = std::stoi(argv[3]); }
+                if (argc >= 5 && !parse_backend(argv[4], worker_config.backend))
+                    std::cerr << "Backend tidak dikenal: " << argv[4] << ", memakai openmp\n";
+                if (argc >= 6) worker_config.die_after = std::stoi(argv[5]);
+            } catch(...) { /* biarkan default jika parsing gagal */ }
+        } else if (first_arg == "--field") {
+            // ./prog --field out.frf [width height] [--view min_re max_re min_im] [--julia re im] [--iter N] [--png out.png]
+            field_mode = true;
+            int i = 2;
+            if (i < argc && argv[i][0] != '-') field_config.path = argv[i++];
+            try {
+                if (i + 1 < argc && argv[i][0] != '-') {
+                    field_config.width = std::max(2, std::stoi(argv[i]));
+                    field_config.height = std::max(2, std::stoi(argv[i + 1]));
+                    i += 2;
+                }
+                for (; i < argc; ++i) {
+                    std::string opt = argv[i];
+                    if (opt == "--view" && i + 3 < argc) {
+                        field_config.min_re = std::stof(argv[++i]);
+                        field_config.max_re = std::stof(argv[++i]);
+                        field_config.min_im = std::stof(argv[++i]);
+                    } else if (opt == "--julia" && i + 2 < argc) {
+                        field_config.is_julia = true;
+                        float re = std::stof(argv[++i]);
+                        field_config.julia_c = {re, std::stof(argv[++i])};
+                    }
+                    else if (opt == "--iter" && i + 1 < argc) field_config.max_iterations = std::max(1, std::stoi(argv[++i]));
+                    else if (opt == "--png" && i + 1 < argc) field_config.png_path = argv[++i];
+                    else std::cerr << "Opsi tidak dikenal: " << opt << "\n";
+                }
+            } catch(...) { std::cerr << "Argumen --field tidak valid, sisa opsi diabaikan\n"; }
+        } else if (first_arg == "--colorize-field") {
+            // ./prog --colorize-field in.frf [out.png] [--palette classic|smooth|cyclic] [--cycle N] [--shade]
+            colorize_field_mode = true;
+            int i = 2;
+            if (i < argc) colorize_config.path = argv[i++];
+            if (i < argc && argv[i][0] != '-') colorize_config.png_path = argv[i++];
+            for (; i < argc; ++i) {
+                std::string opt = argv[i];
+                if (opt == "--shade") colorize_config.shade = true;
+                else if (opt == "--palette" && i + 1 < argc) colorize_config.palette = argv[++i];
+                else if (opt == "--cycle" && i + 1 < argc) { try { colorize_config.cycle = std::max(1.0f, std::stof(argv[++i])); } catch(...) {} }
+                else std::cerr << "Opsi tidak dikenal: " << opt << "\n";
+            }
+        } else if (first_arg == "--checkpoint") {
+            // ./prog --checkpoint file.ckpt [width height] [--view min_re max_re min_im] [--julia re im]
+            //        [--iter N] [--tile N] [--interval S] [--out file.png]
+            checkpoint_mode = true;
+            int i = 2;
+            if (i < argc) checkpoint_config.path = argv[i++];
+            try {
+                if (i + 1 < argc && argv[i][0] != '-') {
+                    checkpoint_config.width = std::max(2, std::stoi(argv[i]));
+                    checkpoint_config.height = std::max(2, std::stoi(argv[i + 1]));
+                    i += 2;
+                }
+                for (; i < argc; ++i) {
+                    std::string opt = argv[i];
+                    if (opt == "--view" && i + 3 < argc) {
+                        checkpoint_config.min_re = std::stof(argv[++i]);
+                        checkpoint_config.max_re = std::stof(argv[++i]);
+                        checkpoint_config.min_im = std::stof(argv[++i]);
+                    } else if (opt == "--julia" && i + 2 < argc) {
+                        checkpoint_config.is_julia = true;
+                        float re = std::stof(argv[++i]);
+                        checkpoint_config.julia_c = {re, std::stof(argv[++i])};
+                    }
+                    else if (opt == "--iter" && i + 1 < argc) checkpoint_config.max_iterations = std::max(1, std::stoi(argv[++i]));
+                    else if (opt == "--tile" && i + 1 < argc) checkpoint_config.tile_size = std::max(8, std::stoi(argv[++i]));
+                    else if (opt == "--interval" && i + 1 < argc) checkpoint_config.interval_seconds = std::max(0.0, std::stod(argv[++i]));
+                    else if (opt == "--out" && i + 1 < argc) checkpoint_config.output_png = argv[++i];
+                    else std::cerr << "Opsi tidak dikenal: " << opt << "\n";
+                }
+            } catch(...) { std::cerr << "Argumen --checkpoint tidak valid, sisa opsi diabaikan\n"; }
+        } else if (first_arg == "--checkpoint-status") {
+            // ./prog --checkpoint-status file.ckpt
+            checkpoint_status_mode = true;
+            if (argc >= 3) checkpoint_config.path = argv[2];
+        } else if (first_arg == "--replay") {
+            // ./prog --replay events.txt [serial|openmp|opencl|auto] [--fast] [--hz N] [--out prefix] [--profile file]
+            //                          [--no-reuse]
+            replay_mode = true;
+            int i = 2;
+            if (i < argc) replay_config.path = argv[i++];
+            if (i < argc && argv[i][0] != '-') {
+                if (std::string(argv[i]) == "auto") replay_config.auto_backend = true;
+                else if (!parse_backend(argv[i], replay_config.backend))
+                    std::cerr << "Backend tidak dikenal: " << argv[i] << ", memakai openmp\n";
+                ++i;
+            }
+            for (; i < argc; ++i) {
+                std::string opt = argv[i];
+                if (opt == "--fast") replay_config.fast = true;
+                else if (opt == "--hz" && i + 1 < argc) { try { replay_config.refresh_hz = std::max(1.0, std::stod(argv[++i])); } catch(...) {} }
+                else if (opt == "--out" && i + 1 < argc) replay_config.output_prefix = argv[++i];
+                else if (opt == "--profile" && i + 1 < argc) replay_config.profile_path = argv[++i];
+                else if (opt == "--no-reuse") replay_config.reuse = false;
+                else std::cerr << "Opsi tidak dikenal: " << opt << "\n";
             }
+        } else if (first_arg == "--stream-server") {
+            // ./prog --stream-server [port [width height]] [--backend serial|openmp|opencl|auto] [--tile N]
+            //                        [--no-delta] [--once]
+            stream_server_mode = true;
+            int i = 2;
+            try {
+                if (i < argc && argv[i][0] != '-') stream_config.port = std::stoi(argv[i++]);
+                if (i + 1 < argc && argv[i][0] != '-') {
+                    stream_config.width = std::max(16, std::stoi(argv[i++]));
+                    stream_config.height = std::max(16, std::stoi(argv[i++]));
+                }
+                for (; i < argc; ++i) {
+                    std::string opt = argv[i];
+                    if (opt == "--backend" && i + 1 < argc) {
+                        std::string name = argv[++i];
+                        stream_config.auto_backend = (name == "auto");
+                        if (!stream_config.auto_backend && !parse_backend(name, stream_config.backend))
+                            std::cerr << "Backend tidak dikenal: " << name << ", memakai openmp\n";
+                    }
+                    else if (opt == "--tile" && i + 1 < argc) stream_config.tile_size = std::min(255, std::max(8, std::stoi(argv[++i])));
+                    else if (opt == "--no-delta") stream_config.delta = false;
+                    else if (opt == "--once") stream_config.once = true;
+                    else std::cerr << "Opsi tidak dikenal: " << opt << "\n";
+                }
+            } catch(...) { std::cerr << "Argumen --stream-server tidak valid, sisa opsi diabaikan\n"; }
+        } else if (first_arg == "--stream-view") {
+            // ./prog --stream-view [host [port]]
+            stream_view_mode = true;
+            if (argc >= 3) stream_host = argv[2];
+            if (argc >= 4) { try { stream_config.port = std::stoi(argv[3]); } catch(...) {} }
+        } else if (first_arg == "--stream-bench") {
+            // ./prog --stream-bench [width height] [--events file] [--backend B] [--no-delta] [--port N] [--out prefix]
+            stream_bench_mode = true;
+            int i = 2;
+            try {
+                if (argc >= 4 && argv[2][0] != '-') {
+                    stream_bench_config.width = std::max(16, std::stoi(argv[2]));
+                    stream_bench_config.height = std::max(16, std::stoi(argv[3]));
+                    i = 4;
+                }
+                for (; i < argc; ++i) {
+                    std::string opt = argv[i];
+                    if (opt == "--events" && i + 1 < argc) stream_bench_config.events_path = argv[++i];
+                    else if (opt == "--backend" && i + 1 < argc) {
+                        if (!parse_backend(argv[++i], stream_bench_config.backend))
+                            std::cerr << "Backend tidak dikenal: " << argv[i] << ", memakai openmp\n";
+                    }
+                    else if (opt == "--no-delta") stream_bench_config.delta = false;
+                    else if (opt == "--port" && i + 1 < argc) stream_bench_config.port = std::stoi(argv[++i]);
+                    else if (opt == "--out" && i + 1 < argc) stream_bench_config.output_prefix = argv[++i];
+                    else std::cerr << "Opsi tidak dikenal: " << opt << "\n";
+                }
+            } catch(...) { std::cerr << "Argumen --stream-bench tidak valid, sisa opsi diabaikan\n"; }
+        } else if (first_arg == "--calibrate-backends") {
+            // ./prog --calibrate-backends [--profile file]
+            calibrate_mode = true;
+            if (argc >= 4 && std::string(argv[2]) == "--profile") profile_path = argv[3];
+        } else if (first_arg == "--expmap") {
+            // ./prog --expmap [width height [frames [end_radius]]] [--center re im] [--start R] [--strip N]
+            //                 [--patch N] [--iter N] [--out prefix] [--save-strip]
+            expmap_mode = true;
+            int i = 2;
+            try {
+                if (argc >= 4 && argv[2][0] != '-') {
+                    expmap_config.width = std::max(2, std::stoi(argv[2]));
+                    expmap_config.height = std::max(2, std::stoi(argv[3]));
+                    i = 4;
+                }
+                if (i < argc && argv[i][0] != '-') expmap_config.frames = std::max(1, std::stoi(argv[i++]));
+                if (i < argc && argv[i][0] != '-') expmap_config.end_radius = std::stod(argv[i++]);
+                for (; i < argc; ++i) {
+                    std::string opt = argv[i];
+                    if (opt == "--save-strip") expmap_config.save_strip = true;
+                    else if (opt == "--center" && i + 2 < argc) {
+                        expmap_config.center_re = std::stod(argv[++i]);
+                        expmap_config.center_im = std::stod(argv[++i]);
+                    }
+                    else if (opt == "--start" && i + 1 < argc) expmap_config.start_radius = std::stod(argv[++i]);
+                    else if (opt == "--strip" && i + 1 < argc) expmap_config.strip_width = std::max(8, std::stoi(argv[++i]));
+                    else if (opt == "--patch" && i + 1 < argc) expmap_config.patch_size = std::max(0, std::stoi(argv[++i]));
+                    else if (opt == "--iter" && i + 1 < argc) expmap_config.max_iterations = std::max(1, std::stoi(argv[++i]));
+                    else if (opt == "--out" && i + 1 < argc) expmap_config.output_prefix = argv[++i];
+                    else std::cerr << "Opsi tidak dikenal: " << opt << "\n";
+                }
+            } catch(...) { std::cerr << "Argumen --expmap tidak valid, sisa opsi diabaikan\n"; }
+            if (!(expmap_config.end_radius > 0) || expmap_config.end_radius >= expmap_config.start_radius)
+                expmap_config.end_radius = expmap_config.start_radius * 1e-5;
         } else { // ./prog 1920 1080
             if (argc == 3) {
                 try {
@@ -453,17 +1219,60 @@ int main(int argc, char* argv[]) {
             }
         }
     }
+    bench_config.width = width;
+    bench_config.height = height;
 
     if (benchmark_mode) {
-        run_benchmarks(width, height);
+        run_benchmarks(bench_config);
+    } else if (atlas_mode) {
+        run_julia_atlas(atlas_config);
+    } else if (serve_mode) {
+        run_tile_server(server_config);
+    } else if (loadgen_mode) {
+        run_tile_loadgen(loadgen_config);
+    } else if (coordinator_mode) {
+        run_coordinator(coordinator_config);
+    } else if (worker_mode) {
+        run_worker(worker_config);
+    } else if (field_mode) {
+        run_field_render(field_config);
+    } else if (colorize_field_mode) {
+        if (colorize_config.path.empty()) std::cerr << "Pemakaian: --colorize-field in.frf [out.png] [--palette P] [--cycle N] [--shade]\n";
+        else run_field_colorize(colorize_config);
+    } else if (checkpoint_mode || checkpoint_status_mode) {
+        if (checkpoint_config.path.empty()) std::cerr << "Pemakaian: --checkpoint file.ckpt [width height] [opsi] | --checkpoint-status file.ckpt\n";
+        else if (checkpoint_mode) run_checkpoint_render(checkpoint_config);
+        else print_checkpoint_status(checkpoint_config.path);
+    } else if (replay_mode) {
+        if (replay_config.path.empty()) std::cerr << "Pemakaian: --replay events.txt [backend|auto] [--fast] [--hz N] [--out prefix]\n";
+        else run_gui_replay(replay_config);
+    } else if (calibrate_mode) {
+        run_backend_calibration(profile_path);
+    } else if (stream_server_mode) {
+        run_stream_server(stream_config);
+    } else if (stream_bench_mode) {
+        run_stream_bench(stream_bench_config);
+    } else if (stream_view_mode) {
+        #ifdef ENABLE_SFML_GUI
+            run_stream_viewer(stream_host, stream_config.port);
+        #else
+            std::cerr << "Viewer streaming membutuhkan SFML (ENABLE_SFML_GUI)\n";
+        #endif
+    } else if (expmap_mode) {
+        run_expmap_zoom(expmap_config);
+    } else if (buddhabrot_mode) {
+        if (buddhabrot_samples <= 0) buddhabrot_samples = 20LL * width * height;
+        run_buddhabrot(width, height, buddhabrot_samples, buddhabrot_mode == 2);
     } else {
         #ifdef ENABLE_SFML_GUI
-            run_interactive_gui(width, height);
+            run_interactive_gui(width, height, record_path);
         #else
             std::cout << "Mode GUI dinonaktifkan. Menjalankan benchmark sebagai gantinya...\n";
-            run_benchmarks(width, height);
+            run_benchmarks(bench_config);
         #endif
     }
 
+    if (!trace_path.empty()) g_profiler.write_chrome_trace(trace_path);
+
     return 0;
 }
@@ -1,6 +1,8 @@
 /*
  * mandelbrot_kernel.cl (Final float version)
  * Kernel OpenCL untuk menghitung iterasi himpunan Mandelbrot atau Julia.
+ * Frame dirender per band: satu peluncuran menghitung baris [row_offset, row_offset + band_rows)
+ * dan menulis ke buffer band (indeks relatif terhadap awal band).
  */
 
 __kernel void generate_fractal(
@@ -14,13 +16,15 @@ __kernel void generate_fractal(
     const int max_iterations,
     const int is_julia,
     const float julia_c_re,
-    const float julia_c_im
+    const float julia_c_im,
+    const int row_offset,
+    const int band_rows
 ) {
     int gid = get_global_id(0);
-    if (gid >= width * height) return;
+    if (gid >= width * band_rows) return;
 
     int px = gid % width;
-    int py = gid / width;
+    int py = gid / width + row_offset;
 
     float re_range = max_re - min_re;
     float im_range = max_im - min_im;
@@ -54,3 +58,41 @@ __kernel void generate_fractal(
     }
     output[gid] = iterations;
 }
+
+
+/*
+ * Atlas himpunan Julia: satu NDRange 3D (x, y, indeks konstanta) merender semua thumbnail
+ * sekaligus ke satu buffer kontigu dengan layout [k][y][x].
+ */
+__kernel void generate_julia_atlas(
+    __global int* output,
+    __global const float2* constants,
+    const int width,
+    const int height,
+    const float min_re,
+    const float max_re,
+    const float min_im,
+    const float max_im,
+    const int max_iterations
+) {
+    int px = get_global_id(0);
+    int py = get_global_id(1);
+    int k = get_global_id(2);
+    if (px >= width || py >= height) return;
+
+    float z_re = min_re + (float)px / (width - 1) * (max_re - min_re);
+    float z_im = min_im + (float)py / (height - 1) * (max_im - min_im);
+    float2 c = constants[k];
+
+    int iterations = 0;
+    while (iterations < max_iterations) {
+        if ((z_re * z_re + z_im * z_im) > 4.0f) {
+            break;
+        }
+        float temp_z_re = z_re * z_re - z_im * z_im + c.x;
+        z_im = 2.0f * z_re * z_im + c.y;
+        z_re = temp_z_re;
+        iterations++;
+    }
+    output[((size_t)k * height + py) * width + px] = iterations;
+}
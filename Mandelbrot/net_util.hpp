@@ -0,0 +1,26 @@
+/**
+ * net_util.hpp
+ * Helper socket TCP (POSIX) yang dipakai oleh mode server/worker/streaming.
+ * Semua fungsi mengembalikan -1 / false jika gagal dan tidak melempar exception.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Membuka socket listen di semua interface. Mengembalikan fd atau -1.
+int tcp_listen(int port, int backlog = 128);
+
+// Menghubungkan ke host:port (TCP_NODELAY aktif). Mengembalikan fd atau -1.
+int tcp_connect(const std::string& host, int port);
+
+// Menerima koneksi baru (TCP_NODELAY aktif). Mengembalikan fd atau -1.
+int tcp_accept(int listen_fd);
+
+// Membaca data yang tersedia (maks. len byte). Mengembalikan jumlah byte, 0 jika koneksi ditutup, <0 jika error.
+long recv_some(int fd, void* data, size_t len);
+bool send_all(int fd, const void* data, size_t len);
+bool recv_all(int fd, void* data, size_t len);
+// Membangunkan thread yang sedang blok di accept/recv pada socket ini.
+void shutdown_socket(int fd);
+void close_socket(int fd);
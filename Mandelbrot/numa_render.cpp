@@ -0,0 +1,304 @@
+/**
+ * numa_render.cpp
+ * Implementasi topologi NUMA, pinning thread, buffer first-touch, render per-node, dan statistik lokalitas.
+ */
+#include "numa_render.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <sstream>
+
+#include <omp.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// =======================================================================================
+// TOPOLOGI & PINNING
+// =======================================================================================
+
+const char* pin_policy_name(PinPolicy policy) {
+    switch (policy) {
+        case PinPolicy::Compact: return "compact";
+        case PinPolicy::Spread: return "spread";
+        default: return "none";
+    }
+}
+
+bool parse_pin_policy(const std::string& name, PinPolicy& policy) {
+    if (name == "none") policy = PinPolicy::None;
+    else if (name == "compact") policy = PinPolicy::Compact;
+    else if (name == "spread") policy = PinPolicy::Spread;
+    else return false;
+    return true;
+}
+
+// Format cpulist sysfs: "0-3,8-11"
+static std::vector<int> parse_cpu_list(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream list(text);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        if (item.empty() || item == "\n") continue;
+        size_t dash = item.find('-');
+        try {
+            int first = std::stoi(item.substr(0, dash));
+            int last = (dash == std::string::npos) ? first : std::stoi(item.substr(dash + 1));
+            for (int c = first; c <= last; ++c) cpus.push_back(c);
+        } catch (...) { /* abaikan entri rusak */ }
+    }
+    return cpus;
+}
+
+// Mask affinity proses saat pertama kali dibaca; dipakai untuk melepas pin (PinPolicy::None)
+static cpu_set_t initial_affinity() {
+    static cpu_set_t mask = [] {
+        cpu_set_t m;
+        CPU_ZERO(&m);
+        if (sched_getaffinity(0, sizeof(m), &m) != 0)
+            for (int c = 0; c < CPU_SETSIZE; ++c) CPU_SET(c, &m);
+        return m;
+    }();
+    return mask;
+}
+
+const NumaTopology& numa_topology() {
+    static NumaTopology topo = [] {
+        NumaTopology t;
+        cpu_set_t allowed = initial_affinity();
+        std::ifstream online("/sys/devices/system/node/online"); // misalnya "0-1"
+        std::string online_text;
+        if (online) std::getline(online, online_text);
+        std::vector<int> online_nodes = parse_cpu_list(online_text);
+        int max_node = online_nodes.empty() ? -1 : *std::max_element(online_nodes.begin(), online_nodes.end());
+        for (int node = 0; node <= max_node; ++node) {
+            // Node tanpa CPU (misalnya memori saja) tetap dicatat agar nomor node tidak bergeser
+            std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            std::string text;
+            if (in) std::getline(in, text);
+            std::vector<int> cpus;
+            for (int c : parse_cpu_list(text))
+                if (c < CPU_SETSIZE && CPU_ISSET(c, &allowed)) cpus.push_back(c);
+            t.node_cpus.push_back(cpus);
+        }
+        // Buang node kosong di ekor; jika sysfs tidak ada, anggap satu node berisi semua CPU
+        while (!t.node_cpus.empty() && t.node_cpus.back().empty()) t.node_cpus.pop_back();
+        if (t.node_cpus.empty()) {
+            t.node_cpus.emplace_back();
+            for (int c = 0; c < CPU_SETSIZE; ++c)
+                if (CPU_ISSET(c, &allowed)) t.node_cpus.back().push_back(c);
+        }
+        int max_cpu = 0;
+        for (const auto& cpus : t.node_cpus)
+            for (int c : cpus) max_cpu = std::max(max_cpu, c);
+        t.cpu_node.assign(max_cpu + 1, -1);
+        for (int n = 0; n < t.node_count(); ++n)
+            for (int c : t.node_cpus[n]) t.cpu_node[c] = n;
+        return t;
+    }();
+    return topo;
+}
+
+// Urutan CPU untuk pinning. compact: habiskan node 0 dulu, lalu node 1, ...
+// spread: bergantian antar node agar bandwidth memori semua socket terpakai sejak thread sedikit.
+static std::vector<int> pin_order(const NumaTopology& topo, PinPolicy pin) {
+    std::vector<int> order;
+    if (pin == PinPolicy::Compact) {
+        for (const auto& cpus : topo.node_cpus) order.insert(order.end(), cpus.begin(), cpus.end());
+    } else if (pin == PinPolicy::Spread) {
+        size_t longest = 0;
+        for (const auto& cpus : topo.node_cpus) longest = std::max(longest, cpus.size());
+        for (size_t i = 0; i < longest; ++i)
+            for (const auto& cpus : topo.node_cpus)
+                if (i < cpus.size()) order.push_back(cpus[i]);
+    }
+    return order;
+}
+
+int NumaLayout::row_owner(int row) const {
+    auto it = std::upper_bound(row_begin.begin(), row_begin.end(), row);
+    int node = static_cast<int>(it - row_begin.begin()) - 1;
+    return std::min(std::max(node, 0), node_count() - 1);
+}
+
+void unpin_openmp_threads(int threads) {
+    cpu_set_t mask = initial_affinity();
+    #pragma omp parallel num_threads(std::max(1, threads))
+    sched_setaffinity(0, sizeof(mask), &mask);
+}
+
+NumaLayout make_numa_layout(int threads, int height, PinPolicy pin) {
+    const NumaTopology& topo = numa_topology();
+    NumaLayout layout;
+    layout.threads = std::max(1, threads);
+    layout.pin = pin;
+    layout.thread_node.assign(layout.threads, 0);
+    std::vector<int> order = pin_order(topo, pin);
+    const int nodes = topo.node_count();
+
+    #pragma omp parallel num_threads(layout.threads)
+    {
+        int tid = omp_get_thread_num();
+        if (!order.empty()) {
+            cpu_set_t mask;
+            CPU_ZERO(&mask);
+            CPU_SET(order[tid % order.size()], &mask);
+            sched_setaffinity(0, sizeof(mask), &mask);
+        } else {
+            cpu_set_t mask = initial_affinity();
+            sched_setaffinity(0, sizeof(mask), &mask);
+        }
+        int cpu = sched_getcpu();
+        int node = (cpu >= 0 && cpu < static_cast<int>(topo.cpu_node.size())) ? topo.cpu_node[cpu] : -1;
+        layout.thread_node[tid] = std::min(std::max(node, 0), nodes - 1);
+    }
+
+    // Blok baris per node sebanding dengan jumlah thread di node itu (node tanpa thread tidak dapat baris)
+    std::vector<int> per_node(nodes, 0);
+    for (int node : layout.thread_node) per_node[node]++;
+    layout.row_begin.assign(nodes + 1, 0);
+    long long assigned_threads = 0;
+    for (int n = 0; n < nodes; ++n) {
+        assigned_threads += per_node[n];
+        layout.row_begin[n + 1] = static_cast<int>(static_cast<long long>(height) * assigned_threads / layout.threads);
+    }
+    return layout;
+}
+
+// =======================================================================================
+// BUFFER FRAME FIRST-TOUCH
+// =======================================================================================
+
+NumaFrameBuffer::NumaFrameBuffer(int width, int height) : row_stride(static_cast<size_t>(width) * 3), w(width), h(height) {
+    bytes = row_stride * height;
+    if (bytes == 0) return;
+    void* mem = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) throw std::bad_alloc();
+    ptr = static_cast<uint8_t*>(mem);
+}
+
+NumaFrameBuffer::~NumaFrameBuffer() {
+    if (ptr) munmap(ptr, bytes);
+}
+
+void NumaFrameBuffer::first_touch(const NumaLayout& layout) {
+    if (!ptr) return;
+    const int nodes = layout.node_count();
+    // Urutan thread di dalam node-nya: thread ke-j dari k thread menyentuh irisan ke-j blok node
+    std::vector<int> rank(layout.threads), count(nodes, 0);
+    for (int t = 0; t < layout.threads; ++t) rank[t] = count[layout.thread_node[t]]++;
+
+    #pragma omp parallel num_threads(layout.threads)
+    {
+        int tid = omp_get_thread_num();
+        int node = layout.thread_node[tid];
+        long long begin = layout.row_begin[node], len = layout.row_begin[node + 1] - begin;
+        int row0 = static_cast<int>(begin + len * rank[tid] / count[node]);
+        int row1 = static_cast<int>(begin + len * (rank[tid] + 1) / count[node]);
+        if (row1 > row0) std::memset(ptr + row0 * row_stride, 0, (row1 - row0) * row_stride);
+    }
+}
+
+// =======================================================================================
+// RENDER PER-NODE
+// =======================================================================================
+
+static void render_row(uint8_t* row_pixels, int py, int width, int height,
+                       float min_re, float re_range, float min_im, float im_range,
+                       bool is_julia, std::complex<float> julia_c, int max_iterations,
+                       long long& total_iterations, long long& escaped)
+{
+    float cy = min_im + static_cast<float>(py) / (height - 1) * im_range;
+    for (int px = 0; px < width; ++px) {
+        float cx = min_re + static_cast<float>(px) / (width - 1) * re_range;
+        int iterations = point_iterations(cx, cy, is_julia, julia_c, max_iterations);
+        total_iterations += iterations;
+        escaped += (iterations < max_iterations);
+
+        Color color = map_iteration_to_color(iterations, max_iterations);
+        row_pixels[px * 3]     = color.r;
+        row_pixels[px * 3 + 1] = color.g;
+        row_pixels[px * 3 + 2] = color.b;
+    }
+}
+
+void generate_fractal_parallel_numa(
+    const NumaLayout& layout, uint8_t* pixels, size_t stride, int width, int height,
+    float min_re, float max_re, float min_im, float max_im,
+    bool is_julia, std::complex<float> julia_c, int max_iterations, NumaRenderStats* stats)
+{
+    PROFILE_SCOPE("compute_openmp_numa");
+    float re_range = max_re - min_re;
+    float im_range = max_im - min_im;
+    long long total_iterations = 0, escaped = 0, rows_local = 0, rows_stolen = 0;
+
+    const int nodes = layout.node_count();
+    std::unique_ptr<std::atomic<int>[]> next_row(new std::atomic<int>[nodes]);
+    for (int n = 0; n < nodes; ++n) next_row[n].store(layout.row_begin[n]);
+
+    #pragma omp parallel num_threads(layout.threads) reduction(+:total_iterations, escaped, rows_local, rows_stolen)
+    {
+    double thread_start_us = g_profiler.enabled ? g_profiler.now_us() : 0.0;
+    int home = layout.thread_node[omp_get_thread_num()];
+    // Blok node sendiri dulu (setara schedule(dynamic) tetapi tidak pernah lintas socket),
+    // lalu bantu node lain yang masih tersisa barisnya
+    for (int k = 0; k < nodes; ++k) {
+        int node = (home + k) % nodes;
+        int end = layout.row_begin[node + 1];
+        for (int py; (py = next_row[node].fetch_add(1, std::memory_order_relaxed)) < end; ) {
+            render_row(pixels + py * stride, py, width, height, min_re, re_range, min_im, im_range,
+                       is_julia, julia_c, max_iterations, total_iterations, escaped);
+            if (k == 0) rows_local++; else rows_stolen++;
+        }
+    }
+    if (g_profiler.enabled) g_profiler.add_thread_busy(omp_get_thread_num(), thread_start_us, g_profiler.now_us() - thread_start_us);
+    }
+    if (g_profiler.enabled) g_profiler.add_pixel_counts(total_iterations, escaped, static_cast<long long>(width) * height - escaped);
+    if (stats) {
+        stats->rows_local = rows_local;
+        stats->rows_stolen = rows_stolen;
+    }
+}
+
+// =======================================================================================
+// STATISTIK LOKALITAS HALAMAN
+// =======================================================================================
+
+PageLocality measure_page_locality(const NumaLayout& layout, const uint8_t* pixels, size_t stride, int height) {
+    PageLocality result;
+    if (!pixels || height <= 0 || stride == 0) return result;
+    const uintptr_t page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t base = reinterpret_cast<uintptr_t>(pixels);
+    const uintptr_t end = base + stride * height;
+    const size_t CHUNK = 4096;
+
+    std::vector<void*> pages;
+    std::vector<int> status, owners;
+    pages.reserve(CHUNK); status.reserve(CHUNK); owners.reserve(CHUNK);
+    uintptr_t addr = base & ~(page_size - 1);
+    result.available = true;
+    while (addr < end && result.available) {
+        pages.clear(); owners.clear();
+        for (; addr < end && pages.size() < CHUNK; addr += page_size) {
+            uintptr_t first_byte = std::max(addr, base);
+            pages.push_back(reinterpret_cast<void*>(addr));
+            owners.push_back(layout.row_owner(static_cast<int>((first_byte - base) / stride)));
+        }
+        status.assign(pages.size(), -1);
+        // nodes = NULL: move_pages hanya melaporkan node tiap halaman tanpa memindahkannya
+        long rc = syscall(SYS_move_pages, 0, static_cast<unsigned long>(pages.size()), pages.data(),
+                          nullptr, status.data(), 0);
+        if (rc < 0) { result.available = false; break; }
+        for (size_t i = 0; i < pages.size(); ++i) {
+            result.pages++;
+            if (status[i] < 0) result.unknown_pages++;
+            else if (status[i] == owners[i]) result.local_pages++;
+        }
+    }
+    return result;
+}
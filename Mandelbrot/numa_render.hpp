@@ -0,0 +1,98 @@
+/**
+ * numa_render.hpp
+ * Render OpenMP yang sadar NUMA untuk host multi-socket:
+ * - Topologi node dibaca dari /sys/devices/system/node (tanpa libnuma)
+ * - Thread OpenMP bisa di-pin (compact / spread) ke CPU tertentu
+ * - Baris frame dibagi per node; halaman memori di-first-touch oleh thread node pemiliknya
+ * - Di dalam satu node baris diambil dinamis; baris node lain hanya dicuri setelah blok sendiri habis
+ * - Statistik lokalitas: posisi halaman (move_pages) dibandingkan dengan node pemilik baris
+ *
+ * Pada host satu node semuanya tetap berjalan (semua halaman lokal, tidak ada pencurian).
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "fractal_renderer.hpp"
+
+enum class PinPolicy { None, Compact, Spread };
+
+const char* pin_policy_name(PinPolicy policy);
+bool parse_pin_policy(const std::string& name, PinPolicy& policy); // "none" | "compact" | "spread"
+
+struct NumaTopology {
+    std::vector<std::vector<int>> node_cpus; // node_cpus[n] = daftar CPU milik node n
+    std::vector<int> cpu_node;               // cpu_node[cpu] = node (-1 jika tidak diketahui)
+    int node_count() const { return static_cast<int>(node_cpus.size()); }
+};
+
+// Dibaca sekali lalu di-cache. Jika sysfs tidak tersedia, semua CPU dianggap satu node.
+const NumaTopology& numa_topology();
+
+// Pembagian kerja untuk satu jumlah thread: node tiap thread dan blok baris milik tiap node
+// (proporsional terhadap jumlah thread di node tersebut).
+struct NumaLayout {
+    int threads = 1;
+    PinPolicy pin = PinPolicy::None;
+    std::vector<int> thread_node;  // thread_node[tid]
+    std::vector<int> row_begin;    // blok node n = [row_begin[n], row_begin[n + 1])
+    int node_count() const { return static_cast<int>(row_begin.size()) - 1; }
+    int row_owner(int row) const;
+};
+
+// Mem-pin thread OpenMP sesuai kebijakan (pin bertahan di thread pool untuk region berikutnya)
+// lalu mencatat node setiap thread. Dengan PinPolicy::None node diambil dari CPU saat ini.
+NumaLayout make_numa_layout(int threads, int height, PinPolicy pin);
+
+// Mengembalikan affinity setiap thread OpenMP (num_threads = threads) ke mask awal proses.
+void unpin_openmp_threads(int threads);
+
+// Buffer frame dari mmap anonim: halaman belum disentuh sampai first_touch(), sehingga tidak
+// ada zero-fill oleh thread utama yang menaruh seluruh frame di satu node.
+class NumaFrameBuffer {
+public:
+    NumaFrameBuffer() = default;
+    NumaFrameBuffer(int width, int height);
+    ~NumaFrameBuffer();
+    NumaFrameBuffer(const NumaFrameBuffer&) = delete;
+    NumaFrameBuffer& operator=(const NumaFrameBuffer&) = delete;
+
+    // Setiap thread menulis nol ke bagian baris node-nya sendiri.
+    void first_touch(const NumaLayout& layout);
+
+    uint8_t* data() { return ptr; }
+    size_t stride() const { return row_stride; }
+    size_t size() const { return bytes; }
+    int width() const { return w; }
+    int height() const { return h; }
+
+private:
+    uint8_t* ptr = nullptr;
+    size_t bytes = 0, row_stride = 0;
+    int w = 0, h = 0;
+};
+
+struct NumaRenderStats {
+    long long rows_local = 0;   // baris yang dirender oleh thread di node pemiliknya
+    long long rows_stolen = 0;  // baris yang dicuri thread node lain setelah bloknya habis
+};
+
+void generate_fractal_parallel_numa(
+    const NumaLayout& layout, uint8_t* pixels, size_t stride, int width, int height,
+    float min_re, float max_re, float min_im, float max_im,
+    bool is_julia = false, std::complex<float> julia_c = {0,0}, int max_iterations = MAX_ITERATIONS,
+    NumaRenderStats* stats = nullptr);
+
+struct PageLocality {
+    bool available = false;   // false jika kernel tidak mendukung move_pages
+    long long pages = 0;
+    long long local_pages = 0; // halaman yang berada di node pemilik barisnya
+    long long unknown_pages = 0;
+    double local_fraction() const { return pages > unknown_pages ? double(local_pages) / (pages - unknown_pages) : 0.0; }
+};
+
+// Memeriksa node setiap halaman di buffer frame dan membandingkannya dengan NumaLayout.
+PageLocality measure_page_locality(const NumaLayout& layout, const uint8_t* pixels, size_t stride, int height);
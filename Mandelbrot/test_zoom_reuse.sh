@@ -0,0 +1,55 @@
+#!/bin/bash
+# Uji pakai ulang sampel zoom roda: replay sesi sintetis di mana setiap notch roda pertama datang
+# setelah frame yang dirender backend (frame awal, pan, zoom kotak, mode Julia). Zoom masuk 2x
+# tepat di grid lama memakai ulang ~25% sampel; exit 1 jika cache kosong atau rasio di bawah 24%.
+#
+# Pemakaian: ./test_zoom_reuse.sh [binary] [serial|openmp|opencl|auto]
+
+cd "$(dirname "$0")" || exit 1
+
+BINARY="${1:-./fractal_generator}"
+BACKEND="${2:-openmp}"
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "${WORK_DIR}"' EXIT
+
+if [ ! -x "${BINARY}" ]; then
+  echo "Binary ${BINARY} tidak ditemukan (build dulu, lihat README.md)."
+  exit 1
+fi
+
+# Jeda 2 detik antar input agar setiap input mendapat frame sendiri (--fast melompati jedanya)
+cat > "${WORK_DIR}/events.txt" <<'EOF'
+# fractal_generator gui events v1
+size 640 480
+2000 wheel 1 320 240
+4000 down R 300 200
+4010 move 340 230
+4020 up R 340 230
+6000 wheel 1 200 150
+8000 down L 100 100
+8010 up L 400 300
+10000 wheel 1 500 400
+12000 key J
+14000 wheel 1 320 240
+16000 wheel -1 320 240
+18000 close
+EOF
+
+"${BINARY}" --replay "${WORK_DIR}/events.txt" "${BACKEND}" --fast --out "${WORK_DIR}/replay" \
+  > "${WORK_DIR}/replay.log" 2>&1
+cat "${WORK_DIR}/replay.log"
+
+json="${WORK_DIR}/replay.json"
+if [ ! -f "${json}" ]; then
+  echo "Replay gagal: ${json} tidak ditulis."
+  exit 1
+fi
+frames=$(sed -n 's/.*"first_notch_frames": \([0-9]*\).*/\1/p' "${json}")
+fraction=$(sed -n 's/.*"first_notch_reused_fraction": \([0-9.]*\).*/\1/p' "${json}")
+
+# Frame awal + tiga frame backend (pan, zoom kotak, Julia) masing-masing diikuti satu notch
+if [ "${frames}" != "4" ] || ! awk -v f="${fraction}" 'BEGIN { exit !(f >= 0.24) }'; then
+  echo "GAGAL: notch pertama setelah frame backend = ${frames:-?} frame, dipakai ulang ${fraction:-?} (harapan 4 frame, >= 0.24)"
+  exit 1
+fi
+echo "OK: ${frames} notch pertama setelah frame backend memakai ulang ${fraction} sampel"
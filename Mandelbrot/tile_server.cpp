@@ -0,0 +1,391 @@
+/**
+ * tile_server.cpp
+ * Implementasi server tile HTTP dan load generator.
+ */
+#include "tile_server.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+
+#include "net_util.hpp"
+#include "stb_image_write.h"
+
+// =======================================================================================
+// LAYANAN TILE: CACHE, COALESCING, BATCHING
+// =======================================================================================
+
+typedef std::shared_ptr<const std::string> TileData; // PNG terenkode
+
+struct TileServiceStats {
+    std::atomic<long long> requests{0}, cache_hits{0}, coalesced{0}, tiles_rendered{0}, batches{0};
+};
+
+class TileService {
+public:
+    explicit TileService(const TileServerConfig& c) : cfg(c) {
+        dispatcher = std::thread(&TileService::dispatcher_loop, this);
+    }
+    ~TileService() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_all();
+        dispatcher.join();
+    }
+
+    // Mengembalikan PNG tile. Request untuk tile yang sedang dirender menunggu hasil yang sama.
+    TileData get_tile(const std::string& key, const RenderRequest& request) {
+        stats.requests++;
+        std::shared_future<TileData> future;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto cached = cache_index.find(key);
+            if (cached != cache_index.end()) {
+                lru.splice(lru.begin(), lru, cached->second); // tandai sebagai terbaru
+                stats.cache_hits++;
+                return cached->second->second;
+            }
+            auto inflight = in_flight.find(key);
+            if (inflight != in_flight.end()) {
+                stats.coalesced++;
+                future = inflight->second;
+            } else {
+                pending.push_back(PendingTile{key, request, std::promise<TileData>()});
+                future = pending.back().promise.get_future().share();
+                in_flight[key] = future;
+                cv.notify_one();
+            }
+        }
+        return future.get();
+    }
+
+    std::string stats_json() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::stringstream ss;
+        ss << "{\"requests\": " << stats.requests << ", \"cache_hits\": " << stats.cache_hits
+           << ", \"coalesced\": " << stats.coalesced << ", \"tiles_rendered\": " << stats.tiles_rendered
+           << ", \"batches\": " << stats.batches << ", \"cached_tiles\": " << lru.size()
+           << ", \"backend\": \"" << backend_name(cfg.backend) << "\"}\n";
+        return ss.str();
+    }
+
+private:
+    struct PendingTile {
+        std::string key;
+        RenderRequest request;
+        std::promise<TileData> promise;
+    };
+
+    // Mengambil semua tile yang menunggu (maks. max_batch) dan merendernya sebagai satu batch
+    void dispatcher_loop() {
+        for (;;) {
+            std::vector<PendingTile> batch;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [this] { return stopping || !pending.empty(); });
+                if (stopping) return;
+                while (!pending.empty() && static_cast<int>(batch.size()) < cfg.max_batch) {
+                    batch.push_back(std::move(pending.front()));
+                    pending.pop_front();
+                }
+            }
+
+            const int ts = cfg.tile_size;
+            const size_t stride = static_cast<size_t>(ts) * 3;
+            std::vector<std::vector<uint8_t>> buffers(batch.size(), std::vector<uint8_t>(stride * ts));
+            std::vector<RenderRequest> requests;
+            std::vector<uint8_t*> outputs;
+            std::vector<size_t> strides(batch.size(), stride);
+            for (size_t i = 0; i < batch.size(); ++i) {
+                requests.push_back(batch[i].request);
+                outputs.push_back(buffers[i].data());
+            }
+            std::vector<RenderResult> results = renderer.render_batch(requests, outputs, strides);
+
+            std::vector<TileData> encoded(batch.size());
+            #pragma omp parallel for schedule(dynamic)
+            for (int i = 0; i < static_cast<int>(batch.size()); ++i) {
+                if (!results[i].ok) continue;
+                std::string png;
+                stbi_write_png_to_func([](void* ctx, void* data, int size) {
+                    static_cast<std::string*>(ctx)->append(static_cast<const char*>(data), size);
+                }, &png, ts, ts, 3, buffers[i].data(), static_cast<int>(stride));
+                encoded[i] = std::make_shared<const std::string>(std::move(png));
+            }
+
+            stats.batches++;
+            stats.tiles_rendered += static_cast<long long>(batch.size());
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (size_t i = 0; i < batch.size(); ++i) {
+                    in_flight.erase(batch[i].key);
+                    if (!encoded[i]) continue;
+                    lru.push_front({batch[i].key, encoded[i]});
+                    cache_index[batch[i].key] = lru.begin();
+                    if (lru.size() > cfg.cache_tiles) {
+                        cache_index.erase(lru.back().first);
+                        lru.pop_back();
+                    }
+                }
+            }
+            for (size_t i = 0; i < batch.size(); ++i) {
+                if (!results[i].ok) std::cerr << "Render tile " << batch[i].key << " gagal: " << results[i].error << "\n";
+                batch[i].promise.set_value(encoded[i]);
+            }
+        }
+    }
+
+    TileServerConfig cfg;
+    Renderer renderer; // backend dan konteks OpenCL persisten sepanjang umur server
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stopping = false;
+    std::deque<PendingTile> pending;
+    std::unordered_map<std::string, std::shared_future<TileData>> in_flight;
+    std::list<std::pair<std::string, TileData>> lru;
+    std::unordered_map<std::string, std::list<std::pair<std::string, TileData>>::iterator> cache_index;
+    std::thread dispatcher;
+
+public:
+    TileServiceStats stats;
+};
+
+// =======================================================================================
+// HTTP
+// =======================================================================================
+
+// Memetakan path tile ke key cache dan RenderRequest. Mengembalikan false jika path tidak valid.
+// Zoom 0 mencakup persegi berukuran 4 (Mandelbrot: [-2.5, 1.5] x [-2, 2], Julia: [-2, 2] x [-2, 2]).
+static bool parse_tile_path(const std::string& target, const TileServerConfig& cfg,
+                            std::string& key, RenderRequest& request)
+{
+    std::string path = target, query;
+    size_t qpos = target.find('?');
+    if (qpos != std::string::npos) { path = target.substr(0, qpos); query = target.substr(qpos + 1); }
+
+    char fractal[16] = {0};
+    int z, x, y, consumed = 0;
+    if (std::sscanf(path.c_str(), "/%15[a-z]/%d/%d/%d.png%n", fractal, &z, &x, &y, &consumed) != 4 ||
+        consumed != static_cast<int>(path.size()))
+        return false;
+    if (z < 0 || z > max_tile_zoom(cfg.tile_size) || x < 0 || y < 0 || x >= (1 << z) || y >= (1 << z)) return false;
+
+    std::string name = fractal;
+    request = RenderRequest();
+    request.width = request.height = cfg.tile_size;
+    request.backend = cfg.backend;
+    request.max_iterations = cfg.max_iterations;
+    double origin_re, origin_im = -2.0;
+    if (name == "mandelbrot") {
+        origin_re = -2.5;
+    } else if (name == "julia") {
+        origin_re = -2.0;
+        request.is_julia = true;
+        request.julia_c = {-0.7f, 0.27015f};
+        float c_re, c_im;
+        if (query.compare(0, 2, "c=") == 0 && std::sscanf(query.c_str() + 2, "%f,%f", &c_re, &c_im) == 2)
+            request.julia_c = {c_re, c_im};
+    } else {
+        return false;
+    }
+
+    // Jarak antar piksel = span / tile_size sehingga tile bersebelahan menyambung tanpa duplikasi tepi.
+    // Dihitung dalam double agar tepi tile tidak bergeser karena pembulatan x * span di zoom tinggi.
+    double span = 4.0 / static_cast<double>(1 << z);
+    double inner = span * (cfg.tile_size - 1) / cfg.tile_size;
+    double min_re = origin_re + x * span, min_im = origin_im + y * span;
+    request.min_re = static_cast<float>(min_re); request.max_re = static_cast<float>(min_re + inner);
+    request.min_im = static_cast<float>(min_im); request.max_im = static_cast<float>(min_im + inner);
+
+    // Ukuran tile dan batas iterasi ikut menentukan isi PNG, jadi keduanya masuk key (dan ETag)
+    std::stringstream ks;
+    ks << name << '/' << z << '/' << x << '/' << y << '/' << cfg.tile_size << "px/" << cfg.max_iterations << "it";
+    if (request.is_julia) ks << '@' << request.julia_c.real() << ',' << request.julia_c.imag();
+    key = ks.str();
+    return true;
+}
+
+static bool send_response(int fd, int status, const char* status_text, const std::string& content_type,
+                          const std::string& body, const std::string& extra_headers, bool keep_alive)
+{
+    std::stringstream hs;
+    hs << "HTTP/1.1 " << status << ' ' << status_text << "\r\n"
+       << "Content-Type: " << content_type << "\r\n"
+       << "Content-Length: " << body.size() << "\r\n"
+       << extra_headers
+       << "Connection: " << (keep_alive ? "keep-alive" : "close") << "\r\n\r\n";
+    std::string header = hs.str();
+    return send_all(fd, header.data(), header.size()) && send_all(fd, body.data(), body.size());
+}
+
+static void handle_connection(int fd, TileService& service, const TileServerConfig& cfg) {
+    std::string buffer;
+    char chunk[4096];
+    for (;;) {
+        size_t header_end;
+        while ((header_end = buffer.find("\r\n\r\n")) == std::string::npos) {
+            if (buffer.size() > 16384) { close_socket(fd); return; }
+            long n = recv_some(fd, chunk, sizeof(chunk));
+            if (n <= 0) { close_socket(fd); return; }
+            buffer.append(chunk, n);
+        }
+        std::string head = buffer.substr(0, header_end);
+        buffer.erase(0, header_end + 4);
+
+        std::string method, target, version;
+        std::stringstream hs(head);
+        hs >> method >> target >> version;
+        std::string lower = head;
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+        bool keep_alive = version == "HTTP/1.1" && lower.find("connection: close") == std::string::npos;
+        std::string if_none_match;
+        size_t inm = lower.find("if-none-match:");
+        if (inm != std::string::npos) {
+            size_t start = head.find('"', inm), end = start == std::string::npos ? start : head.find('"', start + 1);
+            if (end != std::string::npos) if_none_match = head.substr(start, end - start + 1);
+        }
+
+        bool ok;
+        std::string key;
+        RenderRequest request;
+        if (method != "GET") {
+            ok = send_response(fd, 405, "Method Not Allowed", "text/plain", "GET only\n", "Allow: GET\r\n", keep_alive);
+        } else if (target == "/stats") {
+            ok = send_response(fd, 200, "OK", "application/json", service.stats_json(), "Cache-Control: no-store\r\n", keep_alive);
+        } else if (!parse_tile_path(target, cfg, key, request)) {
+            ok = send_response(fd, 404, "Not Found", "text/plain", "Expected /{mandelbrot|julia}/{z}/{x}/{y}.png\n", "", keep_alive);
+        } else {
+            // Isi tile deterministik terhadap key (termasuk tile_size dan max_iterations), jadi ETag cukup dari hash key
+            std::stringstream etag;
+            etag << '"' << std::hex << std::hash<std::string>()(key) << '"';
+            std::string cache_headers = "Cache-Control: public, max-age=" + std::to_string(cfg.max_age_seconds) +
+                                        ", immutable\r\nETag: " + etag.str() + "\r\n";
+            if (if_none_match == etag.str()) {
+                ok = send_response(fd, 304, "Not Modified", "image/png", "", cache_headers, keep_alive);
+            } else {
+                TileData png = service.get_tile(key, request);
+                if (png) ok = send_response(fd, 200, "OK", "image/png", *png, cache_headers, keep_alive);
+                else ok = send_response(fd, 500, "Internal Server Error", "text/plain", "render failed\n", "", keep_alive);
+            }
+        }
+        if (!ok || !keep_alive) break;
+    }
+    close_socket(fd);
+}
+
+void run_tile_server(const TileServerConfig& cfg) {
+    int listen_fd = tcp_listen(cfg.port);
+    if (listen_fd < 0) {
+        std::cerr << "Error: Gagal listen di port " << cfg.port << "\n";
+        return;
+    }
+    TileService service(cfg);
+    std::cout << "Tile server aktif di port " << cfg.port << " (backend " << backend_name(cfg.backend)
+              << ", tile " << cfg.tile_size << "px, " << cfg.max_iterations << " iterasi, zoom 0-" << max_tile_zoom(cfg.tile_size) << ")\n"
+              << "  GET /mandelbrot/{z}/{x}/{y}.png\n"
+              << "  GET /julia/{z}/{x}/{y}.png?c=-0.7,0.27015\n"
+              << "  GET /stats\n";
+    for (;;) {
+        int fd = tcp_accept(listen_fd);
+        if (fd < 0) continue;
+        std::thread(handle_connection, fd, std::ref(service), std::cref(cfg)).detach();
+    }
+}
+
+// =======================================================================================
+// LOAD GENERATOR
+// =======================================================================================
+
+// Membaca satu response HTTP (header + body sesuai Content-Length). Mengembalikan status atau -1.
+static int read_http_response(int fd, std::string& buffer, size_t& body_bytes) {
+    char chunk[16384];
+    size_t header_end;
+    while ((header_end = buffer.find("\r\n\r\n")) == std::string::npos) {
+        long n = recv_some(fd, chunk, sizeof(chunk));
+        if (n <= 0) return -1;
+        buffer.append(chunk, n);
+    }
+    int status = 0;
+    std::sscanf(buffer.c_str(), "HTTP/1.%*d %d", &status);
+    size_t content_length = 0;
+    std::string lower = buffer.substr(0, header_end);
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    size_t cl = lower.find("content-length:");
+    if (cl != std::string::npos) content_length = std::strtoul(lower.c_str() + cl + 15, nullptr, 10);
+    buffer.erase(0, header_end + 4);
+    while (buffer.size() < content_length) {
+        long n = recv_some(fd, chunk, sizeof(chunk));
+        if (n <= 0) return -1;
+        buffer.append(chunk, n);
+    }
+    buffer.erase(0, content_length);
+    body_bytes = content_length;
+    return status;
+}
+
+void run_tile_loadgen(const LoadGenConfig& cfg) {
+    std::cout << "Load generator: " << cfg.requests << " request ke " << cfg.host << ":" << cfg.port
+              << ", konkurensi " << cfg.concurrency << ", zoom " << cfg.zoom << " (" << cfg.fractal << ")\n";
+
+    std::atomic<int> next{0}, errors{0};
+    std::atomic<long long> bytes{0};
+    std::vector<std::vector<double>> latencies(cfg.concurrency);
+    const int tiles_per_axis = 1 << cfg.zoom;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> clients;
+    for (int t = 0; t < cfg.concurrency; ++t) {
+        clients.emplace_back([&, t] {
+            std::mt19937 rng(1234 + t);
+            std::uniform_int_distribution<int> coord(0, tiles_per_axis - 1);
+            int fd = -1;
+            std::string buffer;
+            while (next.fetch_add(1) < cfg.requests) {
+                if (fd < 0) { fd = tcp_connect(cfg.host, cfg.port); buffer.clear(); }
+                if (fd < 0) { errors++; continue; }
+                std::stringstream req;
+                req << "GET /" << cfg.fractal << '/' << cfg.zoom << '/' << coord(rng) << '/' << coord(rng)
+                    << ".png HTTP/1.1\r\nHost: " << cfg.host << "\r\n\r\n";
+                std::string text = req.str();
+                auto t0 = std::chrono::steady_clock::now();
+                size_t body = 0;
+                int status = send_all(fd, text.data(), text.size()) ? read_http_response(fd, buffer, body) : -1;
+                auto t1 = std::chrono::steady_clock::now();
+                if (status != 200) {
+                    errors++;
+                    close_socket(fd);
+                    fd = -1;
+                    continue;
+                }
+                bytes += static_cast<long long>(body);
+                latencies[t].push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+            }
+            close_socket(fd);
+        });
+    }
+    for (auto& c : clients) c.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> all;
+    for (auto& l : latencies) all.insert(all.end(), l.begin(), l.end());
+    std::sort(all.begin(), all.end());
+    auto pct = [&](double p) {
+        return all.empty() ? 0.0 : all[std::min(all.size() - 1, static_cast<size_t>(std::ceil(p * all.size())) - 1)];
+    };
+    std::cout << std::fixed << std::setprecision(2)
+              << "Selesai: " << all.size() << " OK, " << errors << " error dalam " << seconds << " s\n"
+              << "Throughput: " << all.size() / seconds << " request/s, " << bytes / seconds / 1e6 << " MB/s\n"
+              << "Latensi: p50 " << pct(0.50) << " ms, p90 " << pct(0.90) << " ms, p99 " << pct(0.99)
+              << " ms, max " << (all.empty() ? 0.0 : all.back()) << " ms\n";
+}
@@ -0,0 +1,118 @@
+/**
+ * zoom_reuse.cpp
+ * Implementasi snap zoom pangkat dua dan render yang memakai ulang buffer iterasi.
+ */
+#include "zoom_reuse.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include <omp.h>
+
+static const double ALIGN_TOLERANCE = 0.01; // dalam piksel lama
+static const int MAX_REUSE_STEPS = 4;       // di atas 2^4 sampel yang bisa dipakai < 0.4%
+
+void snap_power_of_two_zoom(float& min_re, float& max_re, float& min_im, float& max_im,
+                            int width, int height, int anchor_x, int anchor_y, int steps)
+{
+    const double sx = (static_cast<double>(max_re) - min_re) / (width - 1);
+    const double sy = (static_cast<double>(max_im) - min_im) / (height - 1);
+    const double f = std::ldexp(1.0, -steps); // piksel lama per piksel baru
+    // Piksel baru X berada di piksel lama a + X * f; titik anchor tetap jika a = anchor * (1 - f)
+    const double ax = std::round(anchor_x * (1.0 - f));
+    const double ay = std::round(anchor_y * (1.0 - f));
+    const double new_min_re = min_re + ax * sx, new_min_im = min_im + ay * sy;
+    min_re = static_cast<float>(new_min_re);
+    max_re = static_cast<float>(new_min_re + sx * f * (width - 1));
+    min_im = static_cast<float>(new_min_im);
+    max_im = static_cast<float>(new_min_im + sy * f * (height - 1));
+}
+
+// Offset dan rasio satu sumbu: posisi piksel baru i di grid lama = offset + i * ratio
+static bool axis_alignment(double old_min, double old_max, double new_min, double new_max, int n,
+                           int& scale_log2, long long& offset)
+{
+    const double old_step = (old_max - old_min) / (n - 1);
+    const double new_step = (new_max - new_min) / (n - 1);
+    if (!(old_step > 0) || !(new_step > 0)) return false;
+    const double l = std::log2(old_step / new_step);
+    scale_log2 = static_cast<int>(std::lround(l));
+    if (std::abs(l - scale_log2) > 1e-4 || std::abs(scale_log2) > MAX_REUSE_STEPS) return false;
+    const double off = (new_min - old_min) / old_step;
+    offset = std::llround(off);
+    return std::abs(off - offset) <= ALIGN_TOLERANCE;
+}
+
+ReuseStats render_with_reuse(IterationCache& cache, const RenderRequest& r, uint8_t* rgb, size_t stride) {
+    PROFILE_SCOPE("compute_reuse");
+    ReuseStats stats;
+    auto start = std::chrono::steady_clock::now();
+    const int w = r.width, h = r.height;
+    const RenderRequest& old = cache.view;
+
+    int lx = 0, ly = 0;
+    long long ox = 0, oy = 0;
+    stats.aligned = cache.valid && old.width == w && old.height == h && old.is_julia == r.is_julia &&
+                    old.julia_c == r.julia_c && old.max_iterations == r.max_iterations &&
+                    axis_alignment(old.min_re, old.max_re, r.min_re, r.max_re, w, lx, ox) &&
+                    axis_alignment(old.min_im, old.max_im, r.min_im, r.max_im, h, ly, oy) && lx == ly;
+    stats.scale_log2 = stats.aligned ? lx : 0;
+
+    // Untuk setiap kolom/baris baru: indeks sampel lama, atau -1 jika harus dihitung
+    std::vector<int> src_x(w, -1), src_y(h, -1);
+    if (stats.aligned) {
+        const int n = stats.scale_log2;
+        auto map_axis = [n](std::vector<int>& src, long long offset, int size) {
+            for (int i = 0; i < size; ++i) {
+                long long u;
+                if (n > 0) {
+                    if (i % (1 << n) != 0) continue;
+                    u = offset + (i >> n);
+                } else {
+                    u = offset + (static_cast<long long>(i) << -n);
+                }
+                if (u >= 0 && u < size) src[i] = static_cast<int>(u);
+            }
+        };
+        map_axis(src_x, ox, w);
+        map_axis(src_y, oy, h);
+    }
+
+    std::vector<int32_t> next(static_cast<size_t>(w) * h);
+    const std::vector<int32_t>& prev = cache.iterations;
+    long long reused = 0;
+    #pragma omp parallel for schedule(dynamic) reduction(+:reused)
+    for (int py = 0; py < h; ++py) {
+        int32_t* row = next.data() + static_cast<size_t>(py) * w;
+        if (src_y[py] < 0) {
+            generate_iterations_region(row, w, w, h, 0, py, w, 1, r.min_re, r.max_re, r.min_im, r.max_im,
+                                       r.is_julia, r.julia_c, r.max_iterations);
+        } else {
+            const int32_t* prev_row = prev.data() + static_cast<size_t>(src_y[py]) * w;
+            // Run piksel yang tidak bisa dipakai ulang dihitung sekaligus
+            int px = 0;
+            while (px < w) {
+                if (src_x[px] >= 0) { row[px] = prev_row[src_x[px]]; ++reused; ++px; continue; }
+                int run = px;
+                while (run < w && src_x[run] < 0) ++run;
+                generate_iterations_region(row + px, w, w, h, px, py, run - px, 1, r.min_re, r.max_re, r.min_im,
+                                           r.max_im, r.is_julia, r.julia_c, r.max_iterations);
+                px = run;
+            }
+        }
+        uint8_t* out = rgb + static_cast<size_t>(py) * stride;
+        for (int px = 0; px < w; ++px) {
+            Color color = map_iteration_to_color(row[px], r.max_iterations);
+            out[px * 3] = color.r; out[px * 3 + 1] = color.g; out[px * 3 + 2] = color.b;
+        }
+    }
+
+    cache.view = r;
+    cache.iterations.swap(next);
+    cache.valid = true;
+    stats.reused = reused;
+    stats.computed = static_cast<long long>(w) * h - reused;
+    stats.elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
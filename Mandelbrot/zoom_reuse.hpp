@@ -0,0 +1,42 @@
+/**
+ * zoom_reuse.hpp
+ * Pemakaian ulang sampel saat zoom dengan faktor pangkat dua.
+ *
+ * Piksel (px, py) frame w x h dipetakan ke min_re + px / (w - 1) * re_range (sama untuk im).
+ * Jika view baru berskala 2^n terhadap view lama dan titik awalnya bergeser sejumlah bulat
+ * piksel lama, maka:
+ *   - zoom masuk 2x : piksel baru (2k, 2m) tepat berada di sampel lama -> 1/4 frame dipakai ulang
+ *   - zoom keluar 2x: setiap piksel baru yang jatuh di dalam frame lama adalah sampel lama
+ *   - pan bulat    : semua piksel yang masih terlihat dipakai ulang
+ * snap_power_of_two_zoom menghasilkan view yang memenuhi syarat tersebut; render_with_reuse
+ * memeriksa syaratnya sendiri (toleransi 1% piksel) dan menghitung hanya piksel sisanya.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "fractal_renderer.hpp"
+
+// Buffer iterasi frame terakhir beserta view-nya
+struct IterationCache {
+    RenderRequest view;
+    std::vector<int32_t> iterations;
+    bool valid = false;
+};
+
+struct ReuseStats {
+    bool aligned = false;   // view baru sejajar dengan grid cache
+    int scale_log2 = 0;     // n: skala baru = skala lama / 2^n (positif = zoom masuk)
+    long long reused = 0, computed = 0;
+    double elapsed_ms = 0.0;
+};
+
+// Zoom 2^steps (positif = masuk) dengan titik piksel (anchor_x, anchor_y) tetap di bawah kursor,
+// dibulatkan sehingga titik awal view baru jatuh tepat di sampel view lama.
+void snap_power_of_two_zoom(float& min_re, float& max_re, float& min_im, float& max_im,
+                            int width, int height, int anchor_x, int anchor_y, int steps);
+
+// Render RGB (OpenMP) untuk `request`; sampel yang sejajar diambil dari cache, sisanya dihitung.
+// Cache selalu diperbarui ke frame baru.
+ReuseStats render_with_reuse(IterationCache& cache, const RenderRequest& request, uint8_t* rgb, size_t stride);
@@ -3,14 +3,22 @@
 SOURCE_FILE="ntt_calculator.c"
 
 EXECUTABLE_NAME="ntt_calculator"
+NATIVE_EXECUTABLE_NAME="ntt_calculator_native"
 
-echo "Compiling ${SOURCE_FILE}..."
+echo "Compiling ${SOURCE_FILE} (bitwise reference)..."
 
-gcc -O3 -Wall -Wextra "${SOURCE_FILE}" -o "${EXECUTABLE_NAME}"
+gcc -O3 -Wall -Wextra -pthread "${SOURCE_FILE}" -o "${EXECUTABLE_NAME}"
+STATUS_REF=$?
 
-if [ $? -eq 0 ]; then
+echo "Compiling ${SOURCE_FILE} (native arithmetic)..."
+
+gcc -O3 -Wall -Wextra -pthread -DNTT_NATIVE "${SOURCE_FILE}" -o "${NATIVE_EXECUTABLE_NAME}"
+STATUS_NATIVE=$?
+
+if [ $STATUS_REF -eq 0 ] && [ $STATUS_NATIVE -eq 0 ]; then
   echo "Success! Program compiled."
-  echo "Run with: ./${EXECUTABLE_NAME}"
+  echo "Run with: ./${EXECUTABLE_NAME}  (reference)"
+  echo "      or: ./${NATIVE_EXECUTABLE_NAME}  (fast)"
 else
   echo "Compilation failed."
 fi
@@ -1,4 +1,13 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+
+/* Kernel SIMD hanya untuk bentuk Montgomery di mode native; dipilih saat runtime sesuai CPU. */
+#if defined(NTT_NATIVE) && !defined(NTT_BARRETT) && defined(__x86_64__)
+#define NTT_SIMD
+#include <immintrin.h>
+#endif
 
 typedef unsigned long long u64;
 typedef __uint128_t u128;
@@ -6,6 +15,8 @@ typedef __uint128_t u128;
 u64 bitwise_add(u64 a, u64 b);
 u64 bitwise_subtract(u64 a, u64 b);
 u64 bitwise_multiply(u64 a, u64 b);
+u128 bitwise_add_u128(u128 a, u128 b);
+u128 bitwise_multiply_u128(u128 a, u128 b);
 u64 bitwise_divide_and_mod_u64(u64 *q_ptr, u64 dividend, u64 divisor);
 u128 bitwise_divide_and_mod_u128(u128 *q_ptr, u128 dividend, u128 divisor);
 
@@ -15,137 +26,730 @@ u128 bitwise_divide_and_mod_u128(u128 *q_ptr, u128 dividend, u128 divisor);
 #define G2 3
 #define P3 167772161
 #define G3 3
+#define P4 754974721
+#define G4 11
 
 u64 bitwise_add(u64 a, u64 b) { u64 c; add_loop: if(b==0)goto add_loop_end; c=(a&b)<<1; a^=b; b=c; goto add_loop; add_loop_end: return a; }
 u64 bitwise_subtract(u64 a, u64 b) { return bitwise_add(a, bitwise_add(~b, 1)); }
 
 u64 bitwise_multiply(u64 a, u64 b) { u64 r=0; multiply_loop: if(b==0)goto multiply_loop_end; if(b&1)r=bitwise_add(r,a); a<<=1; b>>=1; goto multiply_loop; multiply_loop_end: return r; }
 
+u128 bitwise_add_u128(u128 a, u128 b) { u128 c; add_loop: if(b==0)goto add_loop_end; c=(a&b)<<1; a^=b; b=c; goto add_loop; add_loop_end: return a; }
+u128 bitwise_multiply_u128(u128 a, u128 b) { u128 r=0; multiply_loop: if(b==0)goto multiply_loop_end; if(b&1)r=bitwise_add_u128(r,a); a<<=1; b>>=1; goto multiply_loop; multiply_loop_end: return r; }
+
 u64 bitwise_divide_and_mod_u64(u64 *q_ptr, u64 dividend, u64 divisor) { u64 q=0,r=0; int i=63; div_loop: if(i<0)goto div_loop_end; r<<=1; r|= (dividend>>i)&1; if(r>=divisor){r=bitwise_subtract(r,divisor); q|=1ULL<<i;} i=bitwise_subtract(i,1); goto div_loop; div_loop_end: if(q_ptr){*q_ptr=q;} return r; }
 u128 bitwise_divide_and_mod_u128(u128 *q_ptr, u128 dividend, u128 divisor) { u128 q=0,r=0; int i=127; div_loop: if(i<0)goto div_loop_end; r<<=1; r|= (dividend>>i)&1; if(r>=divisor){r=bitwise_subtract(r,divisor); q|=((u128)1)<<i;} i=bitwise_subtract(i,1); goto div_loop; div_loop_end: if(q_ptr){*q_ptr=q;} return r; }
 
-u64 mod_mul(u64 a, u64 b, u64 mod) { u64 r=0; a=bitwise_divide_and_mod_u64(NULL,a,mod); mod_mul_loop: if(b==0)goto mod_mul_loop_end; if(b&1){r=bitwise_add(r,a); if(r>=mod)r=bitwise_subtract(r,mod);} a<<=1; if(a>=mod)a=bitwise_subtract(a,mod); b>>=1; goto mod_mul_loop; mod_mul_loop_end: return r; }
-u64 mod_pow(u64 b, u64 e, u64 m) { u64 r=1; b=bitwise_divide_and_mod_u64(NULL,b,m); mod_pow_loop: if(e==0)goto mod_pow_loop_end; if(e&1)r=mod_mul(r,b,m); b=mod_mul(b,b,m); e>>=1; goto mod_pow_loop; mod_pow_loop_end: return r; }
-u64 mod_inverse(u64 n, u64 mod) { return mod_pow(n, bitwise_subtract(mod, 2), mod); }
-
-int string_length(char* s) { int l=0; len_loop: if(*(s+l)==0)goto len_loop_end; l=bitwise_add(l,1); goto len_loop; len_loop_end: return l; }
-int string_compare(char* s1, char* s2) { compare_loop: if(!(*s1 && (*s1==*s2)))goto compare_loop_end; s1=(char*)bitwise_add((u64)s1,1); s2=(char*)bitwise_add((u64)s2,1); goto compare_loop; compare_loop_end: return *(unsigned char*)s1-*(unsigned char*)s2; }
-
-#define HYBRID_THRESHOLD 20000
-
-#define SIMPLE_NTT_MAX_SIZE 65536
-u64 simple_a[SIMPLE_NTT_MAX_SIZE], simple_b[SIMPLE_NTT_MAX_SIZE];
-
-#define CHUNK_SIZE 5
-#define BASE 100000
-#define COMPLEX_NTT_SIZE 524288
-u64 p1_a[COMPLEX_NTT_SIZE], p1_b[COMPLEX_NTT_SIZE];
-u64 p2_a[COMPLEX_NTT_SIZE], p2_b[COMPLEX_NTT_SIZE];
-u64 p3_a[COMPLEX_NTT_SIZE], p3_b[COMPLEX_NTT_SIZE];
-u128 final_coeffs[COMPLEX_NTT_SIZE];
-
-char s1_in[1000005], s2_in[1000005];
-int result_digits[2000005];
-
-
-void ntt_transform(u64 a[], int n, int invert, u64 prime, u64 root) {
-    int i=1, j=0;
-rev_loop: if(i>=n)goto rev_loop_end; int bit=n>>1; rev_inner_loop: if(!((j&bit)>0))goto rev_inner_loop_end; j^=bit; bit>>=1; goto rev_inner_loop; rev_inner_loop_end: j^=bit;
-    if(i<j){ u64 t=a[i]; a[i]=a[j]; a[j]=t; } i=bitwise_add(i,1); goto rev_loop;
-rev_loop_end:;
-    int len=2;
-len_loop: if(len>n)goto len_loop_end;
-    u64 exponent; u64 p_minus_1 = bitwise_subtract(prime,1);
-    bitwise_divide_and_mod_u64(&exponent, p_minus_1, len);
-    u64 wlen=mod_pow(root, exponent, prime);
-    if(invert)wlen=mod_inverse(wlen, prime);
-    i=0;
-outer_butterfly_loop: if(i>=n)goto outer_butterfly_loop_end;
-    u64 w=1; j=0;
-inner_butterfly_loop: if(j>=(len>>1))goto inner_butterfly_loop_end;
-    u64 u_idx=bitwise_add(i,j); u64 v_idx=bitwise_add(u_idx, len>>1);
-    u64 u=a[u_idx]; u64 v=mod_mul(a[v_idx],w,prime);
-    u64 sum=bitwise_add(u,v); if(sum>=prime)sum=bitwise_subtract(sum,prime); a[u_idx]=sum;
-    u64 diff=bitwise_add(u, bitwise_subtract(prime,v)); if(diff>=prime)diff=bitwise_subtract(diff,prime); a[v_idx]=diff;
-    w=mod_mul(w,wlen,prime); j=bitwise_add(j,1); goto inner_butterfly_loop;
-inner_butterfly_loop_end:
-    i=bitwise_add(i,len); goto outer_butterfly_loop;
-outer_butterfly_loop_end:
-    len<<=1; goto len_loop;
-len_loop_end:;
-    if(invert){ u64 n_inv=mod_inverse(n,prime); i=0;
-inv_loop: if(i>=n)goto inv_loop_end; a[i]=mod_mul(a[i],n_inv,prime); i=bitwise_add(i,1); goto inv_loop;
-inv_loop_end:; }
-}
-
-void run_simple_multiplication(char* s1, int len1, char* s2, int len2) {
-    int n=1; size_loop: if(n>=bitwise_add(len1,len2))goto size_loop_end; n<<=1; goto size_loop; size_loop_end:;
-    int i=0; init_loop: if(i>=n)goto init_loop_end; simple_a[i]=0; simple_b[i]=0; i++; goto init_loop; init_loop_end:;
-    i=0; str_a_loop: if(i>=len1)goto str_a_loop_end; simple_a[i]=s1[bitwise_subtract(len1,bitwise_add(i,1))]-'0'; i++; goto str_a_loop; str_a_loop_end:;
-    i=0; str_b_loop: if(i>=len2)goto str_b_loop_end; simple_b[i]=s2[bitwise_subtract(len2,bitwise_add(i,1))]-'0'; i++; goto str_b_loop; str_b_loop_end:;
-    ntt_transform(simple_a, n, 0, P1, G1); ntt_transform(simple_b, n, 0, P1, G1);
-    i=0; pointwise_loop: if(i>=n)goto pointwise_loop_end; simple_a[i]=mod_mul(simple_a[i],simple_b[i],P1); i++; goto pointwise_loop; pointwise_loop_end:;
-    ntt_transform(simple_a, n, 1, P1, G1);
-    u64 carry=0; i=0; carry_loop: if(i>=n && carry==0)goto carry_loop_end; u64 cur=(i<n?simple_a[i]:0); cur=bitwise_add(cur,carry);
-    result_digits[i]=bitwise_divide_and_mod_u64(&carry,cur,10); i=bitwise_add(i,1); goto carry_loop; carry_loop_end:;
-    int total_digits=i; int start_idx=bitwise_subtract(total_digits,1);
-find_msd_loop: if(start_idx<=0||result_digits[start_idx]!=0)goto find_msd_loop_end; start_idx=bitwise_subtract(start_idx,1); goto find_msd_loop; find_msd_loop_end:;
-    i=start_idx; print_loop: if(i<0)goto print_loop_end; printf("%d", result_digits[i]); i=bitwise_subtract(i,1); goto print_loop; print_loop_end: printf("\n");
+/* Mode aritmetika pipeline, dipilih saat kompilasi:
+ *   default      : referensi, semua operasi lewat loop bitwise di atas
+ *   -DNTT_NATIVE : operator mesin (+, -, *, /, %) dan mod_mul lewat perkalian 128-bit
+ * Kedua mode harus menghasilkan produk yang identik. */
+#ifdef NTT_NATIVE
+static inline u64 arith_add(u64 a, u64 b) { return a+b; }
+static inline u64 arith_subtract(u64 a, u64 b) { return a-b; }
+static inline u64 arith_multiply(u64 a, u64 b) { return a*b; }
+static inline u128 arith_add_u128(u128 a, u128 b) { return a+b; }
+static inline u128 arith_multiply_u128(u128 a, u128 b) { return a*b; }
+static inline u64 arith_divide_and_mod_u64(u64 *q_ptr, u64 dividend, u64 divisor) { if(q_ptr){*q_ptr=dividend/divisor;} return dividend%divisor; }
+static inline u128 arith_divide_and_mod_u128(u128 *q_ptr, u128 dividend, u128 divisor) { if(q_ptr){*q_ptr=dividend/divisor;} return dividend%divisor; }
+u64 mod_mul(u64 a, u64 b, u64 mod) { return (u64)(((u128)a*b)%mod); }
+#else
+#define arith_add bitwise_add
+#define arith_subtract bitwise_subtract
+#define arith_multiply bitwise_multiply
+#define arith_add_u128 bitwise_add_u128
+#define arith_multiply_u128 bitwise_multiply_u128
+#define arith_divide_and_mod_u64 bitwise_divide_and_mod_u64
+#define arith_divide_and_mod_u128 bitwise_divide_and_mod_u128
+u64 mod_mul(u64 a, u64 b, u64 mod) { u64 r=0; a=arith_divide_and_mod_u64(NULL,a,mod); mod_mul_loop: if(b==0)goto mod_mul_loop_end; if(b&1){r=arith_add(r,a); if(r>=mod)r=arith_subtract(r,mod);} a<<=1; if(a>=mod)a=arith_subtract(a,mod); b>>=1; goto mod_mul_loop; mod_mul_loop_end: return r; }
+#endif
+u64 mod_pow(u64 b, u64 e, u64 m) { u64 r=1; b=arith_divide_and_mod_u64(NULL,b,m); mod_pow_loop: if(e==0)goto mod_pow_loop_end; if(e&1)r=mod_mul(r,b,m); b=mod_mul(b,b,m); e>>=1; goto mod_pow_loop; mod_pow_loop_end: return r; }
+u64 mod_inverse(u64 n, u64 mod) { return mod_pow(n, arith_subtract(mod, 2), mod); }
+
+/* Lapisan field per prima NTT. Semua prima < 2^30, elemen disimpan sebagai u32 dalam "bentuk
+ * field" sejak input dimasukkan, selama transform maju, perkalian pointwise dan transform balik;
+ * konversi ke residu biasa hanya terjadi di batas CRT (field_to_int).
+ *   referensi                : bentuk field = residu biasa, field_mul = mod_mul bitwise
+ *   NTT_NATIVE               : bentuk Montgomery a*2^32 mod p, field_mul = 1 perkalian 64-bit + REDC
+ *   NTT_NATIVE + NTT_BARRETT : residu biasa, field_mul = 1 perkalian 64-bit + reduksi Barrett
+ * Semua operasi mengembalikan nilai tereduksi penuh [0, p), jadi representasinya kanonik. */
+typedef unsigned int u32;
+typedef struct { u32 mod, root; u32 mont_inv; u32 mont_r2; u64 barrett_mu; u32* twiddles[2]; int twiddle_size[2]; } prime_field;
+
+void field_init(prime_field* f, u32 mod, u32 root) {
+    f->mod=mod; f->root=root; f->twiddles[0]=f->twiddles[1]=NULL; f->twiddle_size[0]=f->twiddle_size[1]=0;
+#ifdef NTT_NATIVE
+    u32 inv=mod; int k=0; newton_loop: if(k>=4)goto newton_loop_end; inv*=2-mod*inv; k++; goto newton_loop; newton_loop_end:;
+    f->mont_inv=0u-inv;                       /* -p^-1 mod 2^32 */
+    f->mont_r2=(u32)((((u128)1)<<64)%mod);    /* 2^64 mod p */
+    f->barrett_mu=~0ULL/mod;                  /* floor(2^64 / p) */
+#else
+    f->mont_inv=0; f->mont_r2=0; f->barrett_mu=0;
+#endif
+}
+
+#if defined(NTT_NATIVE) && !defined(NTT_BARRETT)
+/* REDC: t < p*2^32 -> t*2^-32 mod p. t + q*p < 2^63 karena p < 2^30. */
+static inline u32 field_reduce(const prime_field* f, u64 t) { u32 q=(u32)t*f->mont_inv; u32 r=(u32)((t+(u64)q*f->mod)>>32); return r>=f->mod?r-f->mod:r; }
+static inline u32 field_mul(const prime_field* f, u32 a, u32 b) { return field_reduce(f,(u64)a*b); }
+static inline u32 field_from_int(const prime_field* f, u32 x) { return field_reduce(f,(u64)x*f->mont_r2); }
+static inline u32 field_to_int(const prime_field* f, u32 a) { return field_reduce(f,a); }
+#elif defined(NTT_NATIVE)
+/* Barrett: t < 2^62, q meleset paling banyak 2 dari t/p. */
+static inline u32 field_reduce(const prime_field* f, u64 t) { u64 q=(u64)(((u128)t*f->barrett_mu)>>64); u64 r=t-q*f->mod; if(r>=f->mod)r-=f->mod; if(r>=f->mod)r-=f->mod; return (u32)r; }
+static inline u32 field_mul(const prime_field* f, u32 a, u32 b) { return field_reduce(f,(u64)a*b); }
+static inline u32 field_from_int(const prime_field* f, u32 x) { return field_reduce(f,x); }
+static inline u32 field_to_int(const prime_field* f, u32 a) { (void)f; return a; }
+#else
+static inline u32 field_mul(const prime_field* f, u32 a, u32 b) { return (u32)mod_mul(a,b,f->mod); }
+static inline u32 field_from_int(const prime_field* f, u32 x) { return (u32)arith_divide_and_mod_u64(NULL,x,f->mod); }
+static inline u32 field_to_int(const prime_field* f, u32 a) { (void)f; return a; }
+#endif
+static inline u32 field_add(const prime_field* f, u32 a, u32 b) { u32 r=(u32)arith_add(a,b); return r>=f->mod?(u32)arith_subtract(r,f->mod):r; }
+static inline u32 field_sub(const prime_field* f, u32 a, u32 b) { return a>=b?(u32)arith_subtract(a,b):(u32)arith_add(a,arith_subtract(f->mod,b)); }
+u32 field_pow(const prime_field* f, u32 b, u64 e) { u32 r=field_from_int(f,1); field_pow_loop: if(e==0)goto field_pow_loop_end; if(e&1)r=field_mul(f,r,b); b=field_mul(f,b,b); e>>=1; goto field_pow_loop; field_pow_loop_end: return r; }
+u32 field_inverse(const prime_field* f, u32 a) { return field_pow(f, a, arith_subtract(f->mod,2)); }
+
+prime_field field_p1, field_p2, field_p3, field_p4;
+
+/* Tabel twiddle per (prima, arah), dalam bentuk field. Stage dengan setengah panjang h memakai
+ * w^j (w = akar primitif ke-2h, atau inversnya untuk arah balik), j = 0..h-1, yang disimpan
+ * berurutan di tw[h .. 2h-1]. Isi stage h tidak bergantung pada ukuran transform, jadi tabel untuk
+ * ukuran n sekaligus melayani semua ukuran yang lebih kecil; tabel hanya dibangun ulang saat
+ * transform yang lebih besar diminta dan dipertahankan antar iterasi REPL. */
+const u32* twiddle_table(prime_field* f, int n, int invert) {
+    if(f->twiddle_size[invert]>=n)return f->twiddles[invert];
+    u32* tw=(u32*)malloc(sizeof(u32)*(size_t)n);
+    if(!tw){ fprintf(stderr,"Memori tidak cukup untuk tabel twiddle %d\n",n); exit(1); }
+    int h=1;
+stage_loop: if(h>=n)goto stage_loop_end;
+    u64 exponent; arith_divide_and_mod_u64(&exponent, arith_subtract(f->mod,1), arith_add(h,h));
+    u32 w=field_pow(f, field_from_int(f,f->root), exponent);
+    if(invert)w=field_inverse(f, w);
+    tw[h]=field_from_int(f,1); int j=1;
+fill_stage_loop: if(j>=h)goto fill_stage_loop_end; tw[arith_add(h,j)]=field_mul(f,tw[arith_subtract(arith_add(h,j),1)],w); j=arith_add(j,1); goto fill_stage_loop;
+fill_stage_loop_end:
+    h<<=1; goto stage_loop;
+stage_loop_end:;
+    free(f->twiddles[invert]); f->twiddles[invert]=tw; f->twiddle_size[invert]=n;
+    return tw;
+}
+
+int string_compare(char* s1, char* s2) { compare_loop: if(!(*s1 && (*s1==*s2)))goto compare_loop_end; s1=(char*)arith_add((u64)s1,1); s2=(char*)arith_add((u64)s2,1); goto compare_loop; compare_loop_end: return *(unsigned char*)s1-*(unsigned char*)s2; }
+
+/* Prima NTT terurut dari yang terbesar, dengan panjang transform maksimumnya (faktor 2 dari p-1). */
+#define NTT_PRIMES 4
+prime_field* ntt_primes[NTT_PRIMES]={&field_p1, &field_p4, &field_p2, &field_p3};
+const int ntt_prime_max_size[NTT_PRIMES]={1<<23, 1<<24, 1<<26, 1<<25};
+#define MAX_CHUNK_DIGITS 9
+
+/* Rencana satu perkalian: `digits` digit desimal per koefisien (basis 10^digits), `primes` prima
+ * NTT, transform n titik, dan jumlah chunk kedua operand. */
+typedef struct { int digits, primes, n, n_chunks1, n_chunks2; u64 base; prime_field* fields[NTT_PRIMES]; } mul_plan;
+
+/* Perencana. Dengan c1, c2 chunk, koefisien konvolusi terbesar paling banyak min(c1,c2)*(10^digits-1)^2;
+ * rencana sah jika batas itu < hasil kali prima yang dipakai (CRT lalu eksak) dan n >= c1+c2-1 tidak
+ * melebihi panjang maksimum tiap prima. Untuk setiap digits = 1..9 dipakai prima terbesar yang
+ * mendukung n, sesedikit mungkin; dari semua rencana sah dipilih biaya terkecil,
+ * biaya ~ primes * n * (3 log n + primes): tiga transform per prima plus Garner.
+ * Mengembalikan 0 jika input terlalu besar untuk semua rencana. */
+int plan_multiplication(int len1, int len2, mul_plan* plan) {
+    u64 best_cost=0; int found=0, digits=1; u64 base=10;
+digits_loop: if(digits>MAX_CHUNK_DIGITS)goto digits_loop_end;
+    mul_plan cand; cand.digits=digits; cand.base=base; cand.primes=0;
+    cand.n_chunks1=(len1+digits-1)/digits; cand.n_chunks2=(len2+digits-1)/digits;
+    cand.n=1; int log_n=0;
+plan_size_loop: if(cand.n>=cand.n_chunks1+cand.n_chunks2-1)goto plan_size_loop_end; cand.n<<=1; log_n++; goto plan_size_loop;
+plan_size_loop_end:;
+    u128 bound=(u128)(cand.n_chunks1<cand.n_chunks2?cand.n_chunks1:cand.n_chunks2)*(base-1)*(base-1), modulus=1;
+    int i=0;
+plan_prime_loop: if(i>=NTT_PRIMES)goto plan_prime_loop_end;
+    if(ntt_prime_max_size[i]<cand.n){ i++; goto plan_prime_loop; }
+    cand.fields[cand.primes++]=ntt_primes[i]; modulus*=ntt_primes[i]->mod;
+    if(bound>=modulus){ i++; goto plan_prime_loop; }
+    u64 cost=(u64)cand.primes*cand.n*(3*log_n+cand.primes);
+    if(!found||cost<best_cost){ found=1; best_cost=cost; *plan=cand; }
+plan_prime_loop_end:
+    digits++; base*=10; goto digits_loop;
+digits_loop_end:
+    return found;
+}
+
+/* Buffer kerja di heap. Buffer hanya tumbuh dan dipakai ulang antar iterasi REPL; input tidak punya
+ * batas panjang tetap selain rencana yang sah. */
+u32 *work_a[NTT_PRIMES], *work_b[NTT_PRIMES]; int work_size[NTT_PRIMES];
+u128* final_coeffs; size_t final_coeffs_size;
+char *s1_in, *s2_in; size_t s1_size, s2_size;
+char* result_digits; size_t result_digits_size;
+
+void* grow_buffer(void* buf, size_t* size, size_t needed, size_t elem) {
+    if(*size>=needed)return buf;
+    size_t cap=*size?*size:4096;
+grow_loop: if(cap>=needed)goto grow_loop_end; cap<<=1; goto grow_loop; grow_loop_end:;
+    void* p=realloc(buf, cap*elem);
+    if(!p){ fprintf(stderr,"Memori tidak cukup (%zu byte)\n",cap*elem); exit(1); }
+    *size=cap; return p;
+}
+
+/* Array residu kedua operand untuk `primes` prima dengan panjang n; isi lama tidak dipertahankan. */
+void ensure_work_buffers(int n, int primes) {
+    int k=0;
+alloc_loop: if(k>=primes)return;
+    if(work_size[k]<n){
+        free(work_a[k]); free(work_b[k]);
+        work_a[k]=(u32*)malloc(sizeof(u32)*(size_t)n); work_b[k]=(u32*)malloc(sizeof(u32)*(size_t)n);
+        if(!work_a[k]||!work_b[k]){ fprintf(stderr,"Memori tidak cukup untuk transform %d\n",n); exit(1); }
+        work_size[k]=n;
+    }
+    k++; goto alloc_loop;
+}
+
+/* Baca satu token (dipisah whitespace) ke buffer yang tumbuh. Mengembalikan panjangnya, -1 jika EOF. */
+long read_token(char** buf, size_t* size) {
+    int c=getchar_unlocked();
+skip_loop: if(c==EOF)return -1; if(c!=' '&&c!='\n'&&c!='\t'&&c!='\r')goto skip_loop_end; c=getchar_unlocked(); goto skip_loop;
+skip_loop_end:;
+    size_t len=0;
+read_loop: if(c==EOF||c==' '||c=='\n'||c=='\t'||c=='\r')goto read_loop_end;
+    if(len+1>=*size)*buf=(char*)grow_buffer(*buf,size,len+2,1);
+    (*buf)[len++]=(char)c; c=getchar_unlocked(); goto read_loop;
+read_loop_end:
+    (*buf)[len]=0; return (long)len;
+}
+
+/* Cetak digit little-endian (nilai 0..9) tanpa nol di depan dengan satu fwrite. Digit dibalik dan
+ * diubah ke ASCII di tempat, jadi buffer butuh satu byte cadangan untuk '\n'. */
+void print_digits(char* digits, int total) {
+    int top=total-1;
+find_msd_loop: if(top<=0||digits[top]!=0)goto find_msd_loop_end; top--; goto find_msd_loop; find_msd_loop_end:;
+    int i=0, j=top;
+reverse_loop: if(i>j)goto reverse_loop_end; char t=digits[i]; digits[i]=(char)('0'+digits[j]); digits[j]=(char)('0'+t); i++; j--; goto reverse_loop;
+reverse_loop_end:
+    digits[top+1]='\n'; fwrite(digits,1,(size_t)top+2,stdout);
     fflush(stdout);
 }
 
-u64 string_to_u64(char* s, int len) { u64 res=0; int i=0; s_to_u64_loop: if(i>=len)return res; res=bitwise_multiply(res,10); res=bitwise_add(res, bitwise_subtract(s[i],'0')); i=bitwise_add(i,1); goto s_to_u64_loop; }
-int fill_coeffs_chunked(u64 arr[], char* s, int slen) { int nc=0; int cpos=slen; fill_loop: if(cpos<=0)goto fill_loop_end; int cstart = cpos > CHUNK_SIZE ? bitwise_subtract(cpos,CHUNK_SIZE) : 0; int clen=bitwise_subtract(cpos,cstart); arr[nc]=string_to_u64(s+cstart,clen); nc=bitwise_add(nc,1); cpos=bitwise_subtract(cpos,CHUNK_SIZE); goto fill_loop; fill_loop_end: return nc; }
-
-void run_complex_multiplication(char* s1, int len1, char* s2, int len2) {
-    int n_chunks1 = fill_coeffs_chunked(p1_a, s1, len1); int n_chunks2 = fill_coeffs_chunked(p1_b, s2, len2);
-    int i=0; copy_loop: if(i>=COMPLEX_NTT_SIZE)goto copy_loop_end; p2_a[i]=p3_a[i]=p1_a[i]; p2_b[i]=p3_b[i]=p1_b[i]; i++; goto copy_loop; copy_loop_end:;
-    ntt_transform(p1_a, COMPLEX_NTT_SIZE, 0, P1, G1); ntt_transform(p1_b, COMPLEX_NTT_SIZE, 0, P1, G1);
-    ntt_transform(p2_a, COMPLEX_NTT_SIZE, 0, P2, G2); ntt_transform(p2_b, COMPLEX_NTT_SIZE, 0, P2, G2);
-    ntt_transform(p3_a, COMPLEX_NTT_SIZE, 0, P3, G3); ntt_transform(p3_b, COMPLEX_NTT_SIZE, 0, P3, G3);
-    i=0; pointwise_loop_c: if(i>=COMPLEX_NTT_SIZE)goto pointwise_loop_c_end; p1_a[i]=mod_mul(p1_a[i],p1_b[i],P1); p2_a[i]=mod_mul(p2_a[i],p2_b[i],P2); p3_a[i]=mod_mul(p3_a[i],p3_b[i],P3); i++; goto pointwise_loop_c; pointwise_loop_c_end:;
-    ntt_transform(p1_a, COMPLEX_NTT_SIZE, 1, P1, G1); ntt_transform(p2_a, COMPLEX_NTT_SIZE, 1, P2, G2); ntt_transform(p3_a, COMPLEX_NTT_SIZE, 1, P3, G3);
-    u64 inv_p1_p2=mod_inverse(P1,P2); u64 inv_p1p2_p3=mod_mul(mod_inverse(P1,P3),mod_inverse(P2,P3),P3); u128 M1=(u128)P1; u128 M12=(u128)P1*P2;
-    i=0; crt_loop: if(i>=COMPLEX_NTT_SIZE)goto crt_loop_end; u64 r1=p1_a[i], r2=p2_a[i], r3=p3_a[i];
-    u64 k1=mod_mul(bitwise_add(r2,bitwise_subtract(P2, bitwise_divide_and_mod_u64(NULL,r1,P2))),inv_p1_p2,P2);
-    u64 t2_term_a = bitwise_add(r3, bitwise_subtract(P3, bitwise_divide_and_mod_u64(NULL,r1,P3)));
-    u64 t2_term_b = mod_mul(k1, bitwise_divide_and_mod_u64(NULL,P1,P3), P3);
-    u64 t2 = bitwise_add(t2_term_a, bitwise_subtract(P3, t2_term_b));
-    u64 k2=mod_mul(t2,inv_p1p2_p3,P3);
-    final_coeffs[i] = bitwise_add(bitwise_add((u128)r1, bitwise_multiply((u128)k1, M1)), bitwise_multiply((u128)k2, M12));
-    i++; goto crt_loop; crt_loop_end:;
-    u128 carry=0; int max_chunks=bitwise_add(n_chunks1,n_chunks2);
-    i=0; final_carry_loop: if(i>=bitwise_add(max_chunks,2)&&carry==0)goto final_carry_loop_end;
-    u128 cur=final_coeffs[i]; cur=bitwise_add(cur,carry);
-    u128 chunk_val=bitwise_divide_and_mod_u128(&carry,cur,BASE);
+/* Kernel butterfly. Setiap kernel memproses satu stage (atau dua untuk radix-4) atas `blocks`
+ * blok berurutan mulai dari x, dan di setiap blok hanya posisi j0 <= j < j1 (rentang j dipakai
+ * untuk membagi stage besar). tw adalah tabel twiddle lengkap (twiddle stage h ada di tw + h).
+ *   dif2 (setengah h) : lo' = u+v,    hi' = (u-v)*w              (satu stage DIF)
+ *   dit2 (setengah h) : lo' = u+v*w,  hi' = u-v*w                (satu stage DIT)
+ *   dif4 (seperempat q): stage DIF setengah 2q lalu q dalam satu pass atas x + {0,q,2q,3q}
+ *   dit4 (seperempat q): stage DIT setengah q lalu 2q dalam satu pass
+ * Varian radix-4 melakukan operasi field yang sama persis dengan dua stage radix-2, hanya
+ * menghemat satu pass memori. Semua kernel menghasilkan nilai tereduksi penuh, jadi hasil SIMD
+ * identik bit per bit dengan scalar. Kernel selebar L lane hanya dipakai jika panjang baris
+ * (h atau q) kelipatan L; stage yang lebih kecil jatuh ke kernel yang lebih sempit
+ * (AVX-512 -> AVX2 -> scalar). Tiga stage terkecil (setengah 4, 2, 1) ditangani sekaligus oleh
+ * dif_tail8 / dit_head8 atas blok 8 elemen; versi AVX2 mengerjakannya di register dengan
+ * permute antar-lane sehingga tidak ada stage yang jatuh ke scalar. */
+typedef void (*stage_kernel)(u32* x, int span, int blocks, int j0, int j1, const u32* tw, const prime_field* f);
+typedef struct {
+    const char* name; int lanes;
+    stage_kernel dif2, dit2, dif4, dit4;
+    void (*pointwise)(u32* a, const u32* b, int count, const prime_field* f);
+    void (*scale)(u32* a, u32 c, int count, const prime_field* f);
+    int tail_blocks; /* dif_tail8/dit_head8 butuh jumlah blok 8 elemen kelipatan ini */
+    void (*dif_tail8)(u32* x, int blocks, const u32* tw, const prime_field* f);
+    void (*dit_head8)(u32* x, int blocks, const u32* tw, const prime_field* f);
+} ntt_kernel;
+
+/* Kerangka loop blok/posisi bersama; badan loop (argumen makro) memakai lo/hi/w (radix-2) atau
+ * x0..x3/w1lo/w1hi/w2 (radix-4) dan j. */
+#define RADIX2_LOOPS(STEP, ...) \
+    int b=0; block_loop: if(b>=blocks)return; { u32* lo=x+(size_t)b*(span<<1); u32* hi=lo+span; const u32* w=tw+span; int j=j0; \
+    pos_loop: if(j>=j1)goto pos_loop_end; __VA_ARGS__ j+=STEP; goto pos_loop; pos_loop_end:; } b++; goto block_loop;
+#define RADIX4_LOOPS(STEP, ...) \
+    int b=0; block_loop: if(b>=blocks)return; { u32* x0=x+(size_t)b*(span<<2); u32* x1=x0+span; u32* x2=x1+span; u32* x3=x2+span; \
+    const u32* w1lo=tw+2*span; const u32* w1hi=w1lo+span; const u32* w2=tw+span; int j=j0; \
+    pos_loop: if(j>=j1)goto pos_loop_end; __VA_ARGS__ j+=STEP; goto pos_loop; pos_loop_end:; } b++; goto block_loop;
+
+void scalar_dif2(u32* x, int span, int blocks, int j0, int j1, const u32* tw, const prime_field* f) {
+    RADIX2_LOOPS(1, { u32 u=lo[j], v=hi[j]; lo[j]=field_add(f,u,v); hi[j]=field_mul(f,field_sub(f,u,v),w[j]); })
+}
+void scalar_dit2(u32* x, int span, int blocks, int j0, int j1, const u32* tw, const prime_field* f) {
+    RADIX2_LOOPS(1, { u32 u=lo[j], v=field_mul(f,hi[j],w[j]); lo[j]=field_add(f,u,v); hi[j]=field_sub(f,u,v); })
+}
+void scalar_dif4(u32* x, int span, int blocks, int j0, int j1, const u32* tw, const prime_field* f) {
+    RADIX4_LOOPS(1, {
+    u32 y0=field_add(f,x0[j],x2[j]), y2=field_mul(f,field_sub(f,x0[j],x2[j]),w1lo[j]);
+    u32 y1=field_add(f,x1[j],x3[j]), y3=field_mul(f,field_sub(f,x1[j],x3[j]),w1hi[j]);
+    x0[j]=field_add(f,y0,y1); x1[j]=field_mul(f,field_sub(f,y0,y1),w2[j]);
+    x2[j]=field_add(f,y2,y3); x3[j]=field_mul(f,field_sub(f,y2,y3),w2[j]); })
+}
+void scalar_dit4(u32* x, int span, int blocks, int j0, int j1, const u32* tw, const prime_field* f) {
+    RADIX4_LOOPS(1, {
+    u32 v1=field_mul(f,x1[j],w2[j]), v3=field_mul(f,x3[j],w2[j]);
+    u32 y0=field_add(f,x0[j],v1), y1=field_sub(f,x0[j],v1), y2=field_add(f,x2[j],v3), y3=field_sub(f,x2[j],v3);
+    u32 z2=field_mul(f,y2,w1lo[j]), z3=field_mul(f,y3,w1hi[j]);
+    x0[j]=field_add(f,y0,z2); x2[j]=field_sub(f,y0,z2);
+    x1[j]=field_add(f,y1,z3); x3[j]=field_sub(f,y1,z3); })
+}
+void scalar_pointwise(u32* a, const u32* b, int count, const prime_field* f) { int j=0; loop: if(j>=count)return; a[j]=field_mul(f,a[j],b[j]); j=arith_add(j,1); goto loop; }
+void scalar_scale(u32* a, u32 c, int count, const prime_field* f) { int j=0; loop: if(j>=count)return; a[j]=field_mul(f,a[j],c); j=arith_add(j,1); goto loop; }
+void scalar_dif_tail8(u32* x, int blocks, const u32* tw, const prime_field* f) { scalar_dif2(x,4,blocks,0,4,tw,f); scalar_dif2(x,2,blocks*2,0,2,tw,f); scalar_dif2(x,1,blocks*4,0,1,tw,f); }
+void scalar_dit_head8(u32* x, int blocks, const u32* tw, const prime_field* f) { scalar_dit2(x,1,blocks*4,0,1,tw,f); scalar_dit2(x,2,blocks*2,0,2,tw,f); scalar_dit2(x,4,blocks,0,4,tw,f); }
+
+#ifdef NTT_SIMD
+/* Montgomery 8 lane: hasil kali 64-bit lane genap dan ganjil dihitung terpisah (mul_epu32), REDC
+ * seperti field_reduce, lalu bagian atas 32-bit digabung kembali. min(x, x-p) tanpa tanda
+ * = reduksi kondisional [0,2p) -> [0,p); min(d, d+p) = koreksi pengurangan yang negatif. */
+__attribute__((target("avx2"))) static inline __m256i avx2_mul(__m256i a, __m256i b, __m256i p, __m256i pinv) {
+    __m256i even=_mm256_mul_epu32(a,b), odd=_mm256_mul_epu32(_mm256_srli_epi64(a,32),_mm256_srli_epi64(b,32));
+    even=_mm256_add_epi64(even,_mm256_mul_epu32(_mm256_mul_epu32(even,pinv),p));
+    odd=_mm256_add_epi64(odd,_mm256_mul_epu32(_mm256_mul_epu32(odd,pinv),p));
+    __m256i r=_mm256_blend_epi32(_mm256_srli_epi64(even,32),odd,0xAA);
+    return _mm256_min_epu32(r,_mm256_sub_epi32(r,p));
+}
+__attribute__((target("avx2"))) static inline __m256i avx2_add(__m256i a, __m256i b, __m256i p) { __m256i r=_mm256_add_epi32(a,b); return _mm256_min_epu32(r,_mm256_sub_epi32(r,p)); }
+__attribute__((target("avx2"))) static inline __m256i avx2_sub(__m256i a, __m256i b, __m256i p) { __m256i r=_mm256_sub_epi32(a,b); return _mm256_min_epu32(r,_mm256_add_epi32(r,p)); }
+#define LD8(ptr) _mm256_loadu_si256((const __m256i*)(ptr))
+#define ST8(ptr, v) _mm256_storeu_si256((__m256i*)(ptr), v)
+#define AVX2_CONSTANTS __m256i p=_mm256_set1_epi32((int)f->mod), pinv=_mm256_set1_epi32((int)f->mont_inv)
+
+__attribute__((target("avx2"))) void avx2_dif2(u32* x, int span, int blocks, int j0, int j1, const u32* tw, const prime_field* f) {
+    AVX2_CONSTANTS;
+    RADIX2_LOOPS(8, { __m256i u=LD8(lo+j), v=LD8(hi+j); ST8(lo+j, avx2_add(u,v,p)); ST8(hi+j, avx2_mul(avx2_sub(u,v,p),LD8(w+j),p,pinv)); })
+}
+__attribute__((target("avx2"))) void avx2_dit2(u32* x, int span, int blocks, int j0, int j1, const u32* tw, const prime_field* f) {
+    AVX2_CONSTANTS;
+    RADIX2_LOOPS(8, { __m256i u=LD8(lo+j), v=avx2_mul(LD8(hi+j),LD8(w+j),p,pinv); ST8(lo+j, avx2_add(u,v,p)); ST8(hi+j, avx2_sub(u,v,p)); })
+}
+__attribute__((target("avx2"))) void avx2_dif4(u32* x, int span, int blocks, int j0, int j1, const u32* tw, const prime_field* f) {
+    AVX2_CONSTANTS;
+    RADIX4_LOOPS(8, {
+    __m256i a0=LD8(x0+j), a1=LD8(x1+j), a2=LD8(x2+j), a3=LD8(x3+j), t2=LD8(w2+j);
+    __m256i y0=avx2_add(a0,a2,p), y2=avx2_mul(avx2_sub(a0,a2,p),LD8(w1lo+j),p,pinv);
+    __m256i y1=avx2_add(a1,a3,p), y3=avx2_mul(avx2_sub(a1,a3,p),LD8(w1hi+j),p,pinv);
+    ST8(x0+j, avx2_add(y0,y1,p)); ST8(x1+j, avx2_mul(avx2_sub(y0,y1,p),t2,p,pinv));
+    ST8(x2+j, avx2_add(y2,y3,p)); ST8(x3+j, avx2_mul(avx2_sub(y2,y3,p),t2,p,pinv)); })
+}
+__attribute__((target("avx2"))) void avx2_dit4(u32* x, int span, int blocks, int j0, int j1, const u32* tw, const prime_field* f) {
+    AVX2_CONSTANTS;
+    RADIX4_LOOPS(8, {
+    __m256i a0=LD8(x0+j), a2=LD8(x2+j), t2=LD8(w2+j);
+    __m256i v1=avx2_mul(LD8(x1+j),t2,p,pinv), v3=avx2_mul(LD8(x3+j),t2,p,pinv);
+    __m256i y0=avx2_add(a0,v1,p), y1=avx2_sub(a0,v1,p), y2=avx2_add(a2,v3,p), y3=avx2_sub(a2,v3,p);
+    __m256i z2=avx2_mul(y2,LD8(w1lo+j),p,pinv), z3=avx2_mul(y3,LD8(w1hi+j),p,pinv);
+    ST8(x0+j, avx2_add(y0,z2,p)); ST8(x2+j, avx2_sub(y0,z2,p));
+    ST8(x1+j, avx2_add(y1,z3,p)); ST8(x3+j, avx2_sub(y1,z3,p)); })
+}
+__attribute__((target("avx2"))) void avx2_pointwise(u32* a, const u32* b, int count, const prime_field* f) {
+    AVX2_CONSTANTS; int j=0;
+loop: if(j>=count)return; ST8(a+j, avx2_mul(LD8(a+j),LD8(b+j),p,pinv)); j+=8; goto loop;
+}
+__attribute__((target("avx2"))) void avx2_scale(u32* a, u32 c, int count, const prime_field* f) {
+    AVX2_CONSTANTS; __m256i cv=_mm256_set1_epi32((int)c); int j=0;
+loop: if(j>=count)return; ST8(a+j, avx2_mul(LD8(a+j),cv,p,pinv)); j+=8; goto loop;
+}
+/* Dua blok 8 elemen (r0, r1) sekaligus. Pasangan butterfly dikumpulkan ke U (lo) dan V (hi):
+ *   setengah 4: separuh 128-bit (permute2x128), twiddle tw[4..7] diulang
+ *   setengah 2: pasangan 64-bit (unpacklo/hi_epi64), twiddle tw[2..3] diulang
+ *   setengah 1: elemen genap/ganjil (shift 64-bit + blend), twiddle tw[1] = 1 sehingga
+ *               perkaliannya dilewati (field_mul(x, 1) = x untuk x kanonik)
+ * lalu disusun kembali dengan operasi yang sama. */
+#define AVX2_SPLIT4(r0,r1,U,V) U=_mm256_permute2x128_si256(r0,r1,0x20); V=_mm256_permute2x128_si256(r0,r1,0x31)
+#define AVX2_SPLIT2(r0,r1,U,V) U=_mm256_unpacklo_epi64(r0,r1); V=_mm256_unpackhi_epi64(r0,r1)
+#define AVX2_SPLIT1(r0,r1,U,V) U=_mm256_blend_epi32(r0,_mm256_slli_epi64(r1,32),0xAA); V=_mm256_blend_epi32(_mm256_srli_epi64(r0,32),r1,0xAA)
+#define AVX2_MERGE1(U,V,r0,r1) r0=_mm256_blend_epi32(U,_mm256_slli_epi64(V,32),0xAA); r1=_mm256_blend_epi32(_mm256_srli_epi64(U,32),V,0xAA)
+__attribute__((target("avx2"))) void avx2_dif_tail8(u32* x, int blocks, const u32* tw, const prime_field* f) {
+    AVX2_CONSTANTS;
+    __m256i w4=_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(tw+4))), w2=_mm256_set1_epi64x((long long)(((u64)tw[3]<<32)|tw[2]));
+    int b=0;
+loop: if(b>=blocks)return;
+    __m256i r0=LD8(x+b*8), r1=LD8(x+b*8+8), U, V, S, D;
+    AVX2_SPLIT4(r0,r1,U,V); S=avx2_add(U,V,p); D=avx2_mul(avx2_sub(U,V,p),w4,p,pinv); AVX2_SPLIT4(S,D,r0,r1);
+    AVX2_SPLIT2(r0,r1,U,V); S=avx2_add(U,V,p); D=avx2_mul(avx2_sub(U,V,p),w2,p,pinv); AVX2_SPLIT2(S,D,r0,r1);
+    AVX2_SPLIT1(r0,r1,U,V); S=avx2_add(U,V,p); D=avx2_sub(U,V,p); AVX2_MERGE1(S,D,r0,r1);
+    ST8(x+b*8, r0); ST8(x+b*8+8, r1);
+    b+=2; goto loop;
+}
+__attribute__((target("avx2"))) void avx2_dit_head8(u32* x, int blocks, const u32* tw, const prime_field* f) {
+    AVX2_CONSTANTS;
+    __m256i w4=_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(tw+4))), w2=_mm256_set1_epi64x((long long)(((u64)tw[3]<<32)|tw[2]));
+    int b=0;
+loop: if(b>=blocks)return;
+    __m256i r0=LD8(x+b*8), r1=LD8(x+b*8+8), U, V, S, D;
+    AVX2_SPLIT1(r0,r1,U,V); S=avx2_add(U,V,p); D=avx2_sub(U,V,p); AVX2_MERGE1(S,D,r0,r1);
+    AVX2_SPLIT2(r0,r1,U,V); V=avx2_mul(V,w2,p,pinv); S=avx2_add(U,V,p); D=avx2_sub(U,V,p); AVX2_SPLIT2(S,D,r0,r1);
+    AVX2_SPLIT4(r0,r1,U,V); V=avx2_mul(V,w4,p,pinv); S=avx2_add(U,V,p); D=avx2_sub(U,V,p); AVX2_SPLIT4(S,D,r0,r1);
+    ST8(x+b*8, r0); ST8(x+b*8+8, r1);
+    b+=2; goto loop;
+}
+
+/* Montgomery 16 lane, sama dengan versi AVX2 (penggabungan lane lewat mask blend). */
+__attribute__((target("avx512f"))) static inline __m512i avx512_mul(__m512i a, __m512i b, __m512i p, __m512i pinv) {
+    __m512i even=_mm512_mul_epu32(a,b), odd=_mm512_mul_epu32(_mm512_srli_epi64(a,32),_mm512_srli_epi64(b,32));
+    even=_mm512_add_epi64(even,_mm512_mul_epu32(_mm512_mul_epu32(even,pinv),p));
+    odd=_mm512_add_epi64(odd,_mm512_mul_epu32(_mm512_mul_epu32(odd,pinv),p));
+    __m512i r=_mm512_mask_blend_epi32((__mmask16)0xAAAA,_mm512_srli_epi64(even,32),odd);
+    return _mm512_min_epu32(r,_mm512_sub_epi32(r,p));
+}
+__attribute__((target("avx512f"))) static inline __m512i avx512_add(__m512i a, __m512i b, __m512i p) { __m512i r=_mm512_add_epi32(a,b); return _mm512_min_epu32(r,_mm512_sub_epi32(r,p)); }
+__attribute__((target("avx512f"))) static inline __m512i avx512_sub(__m512i a, __m512i b, __m512i p) { __m512i r=_mm512_sub_epi32(a,b); return _mm512_min_epu32(r,_mm512_add_epi32(r,p)); }
+#define LD16(ptr) _mm512_loadu_si512((const void*)(ptr))
+#define ST16(ptr, v) _mm512_storeu_si512((void*)(ptr), v)
+#define AVX512_CONSTANTS __m512i p=_mm512_set1_epi32((int)f->mod), pinv=_mm512_set1_epi32((int)f->mont_inv)
+
+__attribute__((target("avx512f"))) void avx512_dif2(u32* x, int span, int blocks, int j0, int j1, const u32* tw, const prime_field* f) {
+    AVX512_CONSTANTS;
+    RADIX2_LOOPS(16, { __m512i u=LD16(lo+j), v=LD16(hi+j); ST16(lo+j, avx512_add(u,v,p)); ST16(hi+j, avx512_mul(avx512_sub(u,v,p),LD16(w+j),p,pinv)); })
+}
+__attribute__((target("avx512f"))) void avx512_dit2(u32* x, int span, int blocks, int j0, int j1, const u32* tw, const prime_field* f) {
+    AVX512_CONSTANTS;
+    RADIX2_LOOPS(16, { __m512i u=LD16(lo+j), v=avx512_mul(LD16(hi+j),LD16(w+j),p,pinv); ST16(lo+j, avx512_add(u,v,p)); ST16(hi+j, avx512_sub(u,v,p)); })
+}
+__attribute__((target("avx512f"))) void avx512_dif4(u32* x, int span, int blocks, int j0, int j1, const u32* tw, const prime_field* f) {
+    AVX512_CONSTANTS;
+    RADIX4_LOOPS(16, {
+    __m512i a0=LD16(x0+j), a1=LD16(x1+j), a2=LD16(x2+j), a3=LD16(x3+j), t2=LD16(w2+j);
+    __m512i y0=avx512_add(a0,a2,p), y2=avx512_mul(avx512_sub(a0,a2,p),LD16(w1lo+j),p,pinv);
+    __m512i y1=avx512_add(a1,a3,p), y3=avx512_mul(avx512_sub(a1,a3,p),LD16(w1hi+j),p,pinv);
+    ST16(x0+j, avx512_add(y0,y1,p)); ST16(x1+j, avx512_mul(avx512_sub(y0,y1,p),t2,p,pinv));
+    ST16(x2+j, avx512_add(y2,y3,p)); ST16(x3+j, avx512_mul(avx512_sub(y2,y3,p),t2,p,pinv)); })
+}
+__attribute__((target("avx512f"))) void avx512_dit4(u32* x, int span, int blocks, int j0, int j1, const u32* tw, const prime_field* f) {
+    AVX512_CONSTANTS;
+    RADIX4_LOOPS(16, {
+    __m512i a0=LD16(x0+j), a2=LD16(x2+j), t2=LD16(w2+j);
+    __m512i v1=avx512_mul(LD16(x1+j),t2,p,pinv), v3=avx512_mul(LD16(x3+j),t2,p,pinv);
+    __m512i y0=avx512_add(a0,v1,p), y1=avx512_sub(a0,v1,p), y2=avx512_add(a2,v3,p), y3=avx512_sub(a2,v3,p);
+    __m512i z2=avx512_mul(y2,LD16(w1lo+j),p,pinv), z3=avx512_mul(y3,LD16(w1hi+j),p,pinv);
+    ST16(x0+j, avx512_add(y0,z2,p)); ST16(x2+j, avx512_sub(y0,z2,p));
+    ST16(x1+j, avx512_add(y1,z3,p)); ST16(x3+j, avx512_sub(y1,z3,p)); })
+}
+__attribute__((target("avx512f"))) void avx512_pointwise(u32* a, const u32* b, int count, const prime_field* f) {
+    AVX512_CONSTANTS; int j=0;
+loop: if(j>=count)return; ST16(a+j, avx512_mul(LD16(a+j),LD16(b+j),p,pinv)); j+=16; goto loop;
+}
+__attribute__((target("avx512f"))) void avx512_scale(u32* a, u32 c, int count, const prime_field* f) {
+    AVX512_CONSTANTS; __m512i cv=_mm512_set1_epi32((int)c); int j=0;
+loop: if(j>=count)return; ST16(a+j, avx512_mul(LD16(a+j),cv,p,pinv)); j+=16; goto loop;
+}
+#endif
+
+/* Kernel yang aktif, dari yang terlebar; scalar selalu ada di posisi terakhir. */
+ntt_kernel active_kernels[3]; int active_kernel_count;
+
+/* Pilih kernel sesuai CPU. Env NTT_SIMD=scalar|avx2|avx512 membatasi pilihan (untuk pembanding). */
+void ntt_kernels_init(void) {
+    int limit=2; char* env=getenv("NTT_SIMD");
+    if(env&&string_compare(env,"scalar")==0)limit=0;
+    if(env&&string_compare(env,"avx2")==0)limit=1;
+    active_kernel_count=0;
+#ifdef NTT_SIMD
+    __builtin_cpu_init();
+    if(limit>=2&&__builtin_cpu_supports("avx512f")){ ntt_kernel k={"avx512",16,avx512_dif2,avx512_dit2,avx512_dif4,avx512_dit4,avx512_pointwise,avx512_scale,2,avx2_dif_tail8,avx2_dit_head8}; active_kernels[active_kernel_count++]=k; }
+    if(limit>=1&&__builtin_cpu_supports("avx2")){ ntt_kernel k={"avx2",8,avx2_dif2,avx2_dit2,avx2_dif4,avx2_dit4,avx2_pointwise,avx2_scale,2,avx2_dif_tail8,avx2_dit_head8}; active_kernels[active_kernel_count++]=k; }
+#else
+    (void)limit;
+#endif
+    ntt_kernel k={"scalar",1,scalar_dif2,scalar_dit2,scalar_dif4,scalar_dit4,scalar_pointwise,scalar_scale,1,scalar_dif_tail8,scalar_dit_head8}; active_kernels[active_kernel_count++]=k;
+}
+
+/* Kernel terlebar yang lane-nya membagi count (count selalu pangkat dua). */
+const ntt_kernel* kernel_for(int count) {
+    int i=0, last=(int)arith_subtract(active_kernel_count,1);
+kernel_loop: if(i>=last)return &active_kernels[i];
+    if(count>=active_kernels[i].lanes)return &active_kernels[i];
+    i=arith_add(i,1); goto kernel_loop;
+}
+
+/* Kernel terlebar yang tail/head 8-nya bisa dipakai untuk `blocks` blok 8 elemen. */
+const ntt_kernel* tail_kernel_for(int blocks) {
+    int i=0, last=(int)arith_subtract(active_kernel_count,1);
+kernel_loop: if(i>=last)return &active_kernels[i];
+    if(blocks>=active_kernels[i].tail_blocks)return &active_kernels[i];
+    i=arith_add(i,1); goto kernel_loop;
+}
+
+/* Stage DIT (Cooley-Tukey) setengah 1 .. n/2: tiga stage pertama lewat dit_head8 (n >= 8), sisanya
+ * berpasangan (radix-4) dan stage terakhir radix-2 jika jumlahnya ganjil. Input bit-reversed,
+ * output natural. */
+void dit_stages(u32 a[], int n, const u32* tw, prime_field* f) {
+    int q=1;
+    if(n>=8){ tail_kernel_for(n>>3)->dit_head8(a, n>>3, tw, f); q=8; }
+dit4_loop: if((q<<2)>n)goto dit4_loop_end;
+    kernel_for(q)->dit4(a, q, n/(q<<2), 0, q, tw, f);
+    q<<=2; goto dit4_loop;
+dit4_loop_end:;
+    if(q<n)kernel_for(q)->dit2(a, q, 1, 0, q, tw, f);
+}
+
+/* Thread pool sederhana untuk parallel_for. Thread pemanggil ikut mengerjakan item; setiap job
+ * ditunggu sampai semua worker selesai sebelum job berikutnya dibuat, jadi worker selalu melihat
+ * job secara berurutan. parallel_for hanya dipanggil dari thread utama (tidak bersarang).
+ * ntt_threads = 1 berarti semua item dikerjakan berurutan di thread pemanggil. */
+typedef void (*parallel_fn)(void* ctx, int index);
+typedef struct { parallel_fn fn; void* ctx; int count; int next; } parallel_job;
+int ntt_threads=1;
+parallel_job pool_job; unsigned pool_generation; int pool_finished;
+pthread_mutex_t pool_lock=PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t pool_wake=PTHREAD_COND_INITIALIZER, pool_idle=PTHREAD_COND_INITIALIZER;
+
+void run_job_items(parallel_job* job) {
+item_loop:;
+    int i=__atomic_fetch_add(&job->next,1,__ATOMIC_RELAXED);
+    if(i>=job->count)return;
+    job->fn(job->ctx,i); goto item_loop;
+}
+
+void* pool_worker(void* arg) {
+    (void)arg; unsigned seen=0;
+    pthread_mutex_lock(&pool_lock);
+worker_loop:
+    if(pool_generation==seen){ pthread_cond_wait(&pool_wake,&pool_lock); goto worker_loop; }
+    seen=pool_generation;
+    pthread_mutex_unlock(&pool_lock);
+    run_job_items(&pool_job);
+    pthread_mutex_lock(&pool_lock);
+    pool_finished++; if(pool_finished==ntt_threads-1)pthread_cond_signal(&pool_idle);
+    goto worker_loop;
+}
+
+void thread_pool_start(int threads) {
+    ntt_threads=threads<1?1:threads; int i=1;
+spawn_loop: if(i>=ntt_threads)return;
+    pthread_t t;
+    if(pthread_create(&t,NULL,pool_worker,NULL)!=0){ ntt_threads=i; return; }
+    pthread_detach(t); i++; goto spawn_loop;
+}
+
+void parallel_for(int count, parallel_fn fn, void* ctx) {
+    if(ntt_threads<=1||count<=1){ int i=0; serial_loop: if(i>=count)return; fn(ctx,i); i++; goto serial_loop; }
+    pthread_mutex_lock(&pool_lock);
+    pool_job.fn=fn; pool_job.ctx=ctx; pool_job.count=count; pool_job.next=0; pool_finished=0; pool_generation++;
+    pthread_cond_broadcast(&pool_wake);
+    pthread_mutex_unlock(&pool_lock);
+    run_job_items(&pool_job);
+    pthread_mutex_lock(&pool_lock);
+wait_loop: if(pool_finished<ntt_threads-1){ pthread_cond_wait(&pool_idle,&pool_lock); goto wait_loop; }
+    pthread_mutex_unlock(&pool_lock);
+}
+
+/* Jumlah potongan untuk pekerjaan sebesar `work` elemen: cukup banyak untuk membagi rata ke semua
+ * thread (4 potongan per thread), tapi tidak lebih kecil dari PARALLEL_MIN_WORK. Selalu pangkat dua. */
+#define PARALLEL_MIN_WORK 8192
+int parallel_parts(int work) {
+    int parts=1;
+parts_loop: if(parts>=ntt_threads*4||(parts<<1)*PARALLEL_MIN_WORK>work)return parts;
+    parts<<=1; goto parts_loop;
+}
+
+/* Pasangan transform tanpa permutasi: maju DIF (Gentleman-Sande) menerima urutan natural dan
+ * meninggalkan hasil dalam urutan bit-reversed; balik DIT menerima urutan bit-reversed dan
+ * mengembalikan urutan natural. Perkalian pointwise tidak peduli urutan, jadi pipeline perkalian
+ * tidak butuh satu pass permutasi pun; faktor n^-1 dilipat ke pointwise_multiply_batch.
+ *
+ * Transform NTT berbatch: semua array (prima x operand) diproses bersamaan.
+ *   - stage besar (setengah >= NTT_BLOCK) berjalan satu per satu; setiap stage dipecah menjadi
+ *     item (array, potongan) sehingga semua thread bekerja pada stage yang sama untuk semua array
+ *   - setelah itu setiap sub-blok NTT_BLOCK elemen saling bebas: DIF/DIT penuh ukuran NTT_BLOCK
+ *     dikerjakan per sub-blok di cache (tanpa sinkronisasi antar stage)
+ * Twiddle stage h tidak bergantung pada ukuran transform, jadi sub-blok memakai tabel yang sama.
+ * Tabel dibangun di thread utama sebelum kerja paralel dimulai. */
+#define NTT_BLOCK (1<<14)
+typedef struct { u32** arrays; prime_field** fields; const u32** tables; int n; int span; int radix; int parts; int dif; } stage_job;
+
+/* Satu potongan satu stage (radix 2 atau 4, seperempat/setengah = span) dari satu array. */
+void stage_item(void* ctx, int index) {
+    stage_job* job=(stage_job*)ctx; int k=index/job->parts, c=index%job->parts;
+    u32* a=job->arrays[k]; prime_field* f=job->fields[k]; const u32* tw=job->tables[k];
+    int block_len=job->span*job->radix, blocks=job->n/block_len;
+    int first_block, block_count, j0, j1;
+    if(blocks>=job->parts){ block_count=blocks/job->parts; first_block=c*block_count; j0=0; j1=job->span; }
+    else { int per_block=job->parts/blocks, width=job->span/per_block; first_block=c/per_block; block_count=1; j0=(c%per_block)*width; j1=j0+width; }
+    const ntt_kernel* kern=kernel_for(j1-j0);
+    stage_kernel fn=job->radix==4?(job->dif?kern->dif4:kern->dit4):(job->dif?kern->dif2:kern->dit2);
+    fn(a+(size_t)first_block*block_len, job->span, block_count, j0, j1, tw, f);
+}
+
+void run_stage(stage_job* job, int count, int span, int radix) {
+    int blocks=job->n/(span*radix), parts=parallel_parts(job->n);
+    /* potongan di dalam satu blok harus tetap selebar kernel SIMD terlebar (16 lane) */
+    int max_parts=blocks*(span>=16?span/16:1);
+    if(parts>max_parts)parts=max_parts;
+    job->span=span; job->radix=radix; job->parts=parts;
+    parallel_for(count*parts, stage_item, job);
+}
+
+void dif_stages(u32 a[], int n, const u32* tw, prime_field* f) {
+    int half=n>>1;
+    int stages=0; count_loop: if((1<<stages)>=n)goto count_loop_end; stages++; goto count_loop; count_loop_end:;
+    int tail=n>=8?3:0;
+    if((stages-tail)&1){ kernel_for(half)->dif2(a, half, 1, 0, half, tw, f); half>>=1; }
+dif4_loop: if(half<(tail?16:2))goto dif4_loop_end;
+    int q=half>>1;
+    kernel_for(q)->dif4(a, q, n/(half<<1), 0, q, tw, f);
+    half>>=2; goto dif4_loop;
+dif4_loop_end:;
+    if(tail)tail_kernel_for(n>>3)->dif_tail8(a, n>>3, tw, f);
+}
+
+typedef struct { u32** arrays; prime_field** fields; const u32** tables; int sub; int blocks; int dif; } block_job;
+void block_item(void* ctx, int index) {
+    block_job* job=(block_job*)ctx; int k=index/job->blocks, b=index%job->blocks;
+    u32* x=job->arrays[k]+(size_t)b*job->sub;
+    if(job->dif)dif_stages(x, job->sub, job->tables[k], job->fields[k]);
+    else dit_stages(x, job->sub, job->tables[k], job->fields[k]);
+}
+
+int log2_int(int n) { int k=0; log_loop: if((1<<k)>=n)return k; k++; goto log_loop; }
+
+void ntt_forward_batch(u32** arrays, prime_field** fields, int count, int n) {
+    const u32* tables[8]; int k=0;
+table_loop: if(k>=count)goto table_loop_end; tables[k]=twiddle_table(fields[k], n, 0); k++; goto table_loop; table_loop_end:;
+    int sub=n<NTT_BLOCK?n:NTT_BLOCK;
+    stage_job sj={arrays, fields, tables, n, 0, 0, 0, 1};
+    int half=n>>1;
+    if(log2_int(n/sub)&1){ run_stage(&sj, count, half, 2); half>>=1; }
+outer_loop: if(half<sub)goto outer_loop_end;
+    run_stage(&sj, count, half>>1, 4); half>>=2; goto outer_loop;
+outer_loop_end:;
+    block_job bj={arrays, fields, tables, sub, n/sub, 1};
+    parallel_for(count*(n/sub), block_item, &bj);
+}
+
+void ntt_inverse_batch(u32** arrays, prime_field** fields, int count, int n) {
+    const u32* tables[8]; int k=0;
+table_loop: if(k>=count)goto table_loop_end; tables[k]=twiddle_table(fields[k], n, 1); k++; goto table_loop; table_loop_end:;
+    int sub=n<NTT_BLOCK?n:NTT_BLOCK;
+    block_job bj={arrays, fields, tables, sub, n/sub, 0};
+    parallel_for(count*(n/sub), block_item, &bj);
+    stage_job sj={arrays, fields, tables, n, 0, 0, 0, 0};
+    int q=sub;
+outer_loop: if((q<<2)>n)goto outer_loop_end;
+    run_stage(&sj, count, q, 4); q<<=2; goto outer_loop;
+outer_loop_end:;
+    if(q<n)run_stage(&sj, count, q, 2);
+}
+
+/* a[k] = a[k] * b[k] * n^-1 per potongan (perkalian pointwise + skala transform balik dalam satu
+ * pass selagi potongannya masih di cache). */
+typedef struct { u32** a; u32** b; prime_field** fields; u32 n_inv[8]; int n; int parts; } pointwise_job;
+void pointwise_item(void* ctx, int index) {
+    pointwise_job* job=(pointwise_job*)ctx; int k=index/job->parts, c=index%job->parts;
+    int len=job->n/job->parts; size_t off=(size_t)c*len; const ntt_kernel* kern=kernel_for(len);
+    kern->pointwise(job->a[k]+off, job->b[k]+off, len, job->fields[k]);
+    kern->scale(job->a[k]+off, job->n_inv[k], len, job->fields[k]);
+}
+void pointwise_multiply_batch(u32** a, u32** b, prime_field** fields, int count, int n) {
+    pointwise_job job; job.a=a; job.b=b; job.fields=fields; job.n=n; job.parts=parallel_parts(n); int k=0;
+ninv_loop: if(k>=count)goto ninv_loop_end; job.n_inv[k]=field_inverse(fields[k], field_from_int(fields[k],n)); k++; goto ninv_loop; ninv_loop_end:;
+    parallel_for(count*job.parts, pointwise_item, &job);
+}
+
+u64 string_to_u64(char* s, int len) { u64 res=0; int i=0; s_to_u64_loop: if(i>=len)return res; res=arith_multiply(res,10); res=arith_add(res, arith_subtract(s[i],'0')); i=arith_add(i,1); goto s_to_u64_loop; }
+int fill_coeffs_chunked(u32 arr[], char* s, int slen, int digits) { int nc=0; int cpos=slen; fill_loop: if(cpos<=0)goto fill_loop_end; int cstart = cpos > digits ? arith_subtract(cpos,digits) : 0; int clen=arith_subtract(cpos,cstart); arr[nc]=(u32)string_to_u64(s+cstart,clen); nc=arith_add(nc,1); cpos=arith_subtract(cpos,digits); goto fill_loop; fill_loop_end: return nc; }
+
+/* Konstanta Garner untuk rencana: prefix[t] = p_0...p_{t-1}, prefix_mod[t][j] = p_0...p_{j-1} mod p_t,
+ * inv_prefix[t] = (p_0...p_{t-1})^-1 mod p_t. */
+typedef struct { const mul_plan* plan; int parts; u64 inv_prefix[NTT_PRIMES], prefix_mod[NTT_PRIMES][NTT_PRIMES]; u128 prefix[NTT_PRIMES]; } mul_job;
+void mul_job_init(mul_job* job, const mul_plan* plan) {
+    job->plan=plan; job->parts=parallel_parts(plan->n); int t=0;
+job_prime_loop: if(t>=plan->primes)return;
+    u64 p=plan->fields[t]->mod, m=1; int j=0;
+job_prefix_loop: if(j>=t)goto job_prefix_loop_end; job->prefix_mod[t][j]=m; m=mod_mul(m,plan->fields[j]->mod,p); j++; goto job_prefix_loop;
+job_prefix_loop_end:
+    job->inv_prefix[t]=mod_inverse(m,p);
+    job->prefix[t]=t?arith_multiply_u128(job->prefix[t-1],plan->fields[t-1]->mod):1;
+    t++; goto job_prime_loop;
+}
+
+/* Konversi chunk ke bentuk field semua prima rencana, per potongan (paralel). */
+void convert_item(void* ctx, int index) {
+    mul_job* job=(mul_job*)ctx; const mul_plan* plan=job->plan; int len=plan->n/job->parts; int i=index*len, end=i+len;
+convert_loop: if(i>=end)return;
+    u32 ca=i<plan->n_chunks1?work_a[0][i]:0, cb=i<plan->n_chunks2?work_b[0][i]:0; int t=0;
+convert_prime_loop: if(t>=plan->primes)goto convert_prime_loop_end;
+    work_a[t][i]=field_from_int(plan->fields[t],ca); work_b[t][i]=field_from_int(plan->fields[t],cb);
+    t++; goto convert_prime_loop;
+convert_prime_loop_end:
+    i++; goto convert_loop;
+}
+
+/* CRT Garner per potongan (paralel): x = sum c_t * prefix[t] dengan
+ * c_t = (r_t - sum_{j<t} c_j * prefix[j]) * prefix[t]^-1 mod p_t. Residu dikonversi keluar dari bentuk
+ * field di sini; x < hasil kali prima < 2^120 selalu muat di u128. */
+void crt_item(void* ctx, int index) {
+    mul_job* job=(mul_job*)ctx; const mul_plan* plan=job->plan; int len=plan->n/job->parts; int i=index*len, end=i+len;
+crt_loop: if(i>=end)return;
+    u64 c[NTT_PRIMES]; u128 x=0; int t=0;
+crt_prime_loop: if(t>=plan->primes)goto crt_prime_loop_end;
+    u64 p=plan->fields[t]->mod, r=field_to_int(plan->fields[t],work_a[t][i]), sum=0; int j=0;
+crt_sum_loop: if(j>=t)goto crt_sum_loop_end; sum=arith_add(sum,mod_mul(c[j],job->prefix_mod[t][j],p)); if(sum>=p)sum=arith_subtract(sum,p); j++; goto crt_sum_loop;
+crt_sum_loop_end:
+    c[t]=mod_mul(arith_add(r,arith_subtract(p,sum)),job->inv_prefix[t],p);
+    x=arith_add_u128(x,arith_multiply_u128((u128)c[t],job->prefix[t]));
+    t++; goto crt_prime_loop;
+crt_prime_loop_end:
+    final_coeffs[i]=x; i++; goto crt_loop;
+}
+
+/* Satu perkalian sesuai rencana: chunk -> bentuk field semua prima -> transform maju berbatch ->
+ * pointwise -> transform balik -> Garner -> carry basis 10^digits -> cetak. */
+void run_multiplication(char* s1, int len1, char* s2, int len2, const mul_plan* plan) {
+    int n=plan->n, k=plan->primes, d=plan->digits;
+    ensure_work_buffers(n, k);
+    final_coeffs=(u128*)grow_buffer(final_coeffs,&final_coeffs_size,(size_t)n,sizeof(u128));
+    int max_chunks=arith_add(plan->n_chunks1,plan->n_chunks2);
+    result_digits=(char*)grow_buffer(result_digits,&result_digits_size,(size_t)arith_multiply(arith_add(max_chunks,2),d)+1,1);
+    fill_coeffs_chunked(work_a[0], s1, len1, d); fill_coeffs_chunked(work_b[0], s2, len2, d);
+    mul_job job; mul_job_init(&job, plan);
+    parallel_for(job.parts, convert_item, &job);
+    u32* fwd[2*NTT_PRIMES]; prime_field* fields[2*NTT_PRIMES]; int t=0;
+batch_loop: if(t>=k)goto batch_loop_end; fwd[t]=work_a[t]; fwd[t+k]=work_b[t]; fields[t]=fields[t+k]=plan->fields[t]; t++; goto batch_loop;
+batch_loop_end:
+    ntt_forward_batch(fwd, fields, 2*k, n);
+    pointwise_multiply_batch(fwd, fwd+k, fields, k, n);
+    ntt_inverse_batch(fwd, fields, k, n);
+    parallel_for(job.parts, crt_item, &job);
+    int i, carry_chunks=(int)arith_add(max_chunks,2);
+    u128 carry=0;
+    i=0; final_carry_loop: if(i>=carry_chunks&&carry==0)goto final_carry_loop_end;
+    u128 cur=i<n?final_coeffs[i]:0; cur=arith_add_u128(cur,carry);
+    u128 chunk_val=arith_divide_and_mod_u128(&carry,cur,plan->base);
     int j=0; u64 temp_chunk=(u64)chunk_val;
-    digit_save_loop: if(j>=CHUNK_SIZE)goto digit_save_loop_end; u64 digit_val;
-    result_digits[bitwise_add(bitwise_multiply(i,CHUNK_SIZE),j)]=bitwise_divide_and_mod_u64(&temp_chunk,temp_chunk,10);
+    digit_save_loop: if(j>=d)goto digit_save_loop_end;
+    result_digits[arith_add(arith_multiply(i,d),j)]=(char)arith_divide_and_mod_u64(&temp_chunk,temp_chunk,10);
     j++; goto digit_save_loop; digit_save_loop_end:;
     i++; goto final_carry_loop; final_carry_loop_end:;
-    int total_digits=bitwise_multiply(i,CHUNK_SIZE);
-    int start_idx=bitwise_subtract(total_digits,1);
-find_msd_loop_c: if(start_idx<=0||result_digits[start_idx]!=0)goto find_msd_loop_c_end; start_idx--; goto find_msd_loop_c; find_msd_loop_c_end:;
-    i=start_idx; print_loop_c: if(i<0)goto print_loop_c_end; printf("%d",result_digits[i]); i--; goto print_loop_c; print_loop_c_end: printf("\n");
-    fflush(stdout);
+    print_digits(result_digits, arith_multiply(i,d));
+}
+
+/* Jumlah thread: opsi -t N / --threads N, lalu env NTT_THREADS, default semua core online. */
+int select_thread_count(int argc, char** argv) {
+    int threads=(int)sysconf(_SC_NPROCESSORS_ONLN);
+    char* env=getenv("NTT_THREADS"); if(env&&atoi(env)>0)threads=atoi(env);
+    int i=1;
+arg_loop: if(i>=argc)goto arg_loop_end;
+    if((string_compare(argv[i],"-t")==0||string_compare(argv[i],"--threads")==0)&&i+1<argc){ threads=atoi(argv[i+1]); i++; }
+    i++; goto arg_loop;
+arg_loop_end:
+    return threads<1?1:threads;
 }
 
-int main() {
+int main(int argc, char** argv) {
+    ntt_kernels_init();
+    thread_pool_start(select_thread_count(argc, argv));
+    field_init(&field_p1, P1, G1); field_init(&field_p2, P2, G2); field_init(&field_p3, P3, G3); field_init(&field_p4, P4, G4);
     printf("Kalkulator Perkalian, 'exit' untuk keluar'\n");
     // fflush(stdout);
 master_loop:
     printf("\n> ");
     // fflush(stdout);
-    if (scanf("%s", s1_in) == EOF) goto master_loop_end;
+    long token1 = read_token(&s1_in, &s1_size);
+    if (token1 < 0) goto master_loop_end;
     if (string_compare(s1_in, "exit") == 0) goto master_loop_end;
-    (void)scanf("%s", s2_in);
-    int len1 = string_length(s1_in); int len2 = string_length(s2_in);
-    int max_len = len1 > len2 ? len1 : len2;
-    if (max_len < HYBRID_THRESHOLD) {
-        run_simple_multiplication(s1_in, len1, s2_in, len2);
-    } else {
-        run_complex_multiplication(s1_in, len1, s2_in, len2);
+    long token2 = read_token(&s2_in, &s2_size);
+    if (token2 < 0) goto master_loop_end;
+    int len1 = (int)token1; int len2 = (int)token2;
+    mul_plan plan;
+    if (!plan_multiplication(len1, len2, &plan)) {
+        fprintf(stderr, "Input terlalu besar untuk semua rencana NTT (%d x %d digit)\n", len1, len2); printf("\n");
+        goto master_loop;
     }
+    run_multiplication(s1_in, len1, s2_in, len2, &plan);
     goto master_loop;
 master_loop_end:
     return 0;
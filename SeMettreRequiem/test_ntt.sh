@@ -0,0 +1,67 @@
+#!/bin/bash
+# Uji kesetaraan: bangun binary referensi (bitwise) dan native (Montgomery, juga Barrett), jalankan
+# input yang sama ke semuanya, lalu bandingkan outputnya. Exit 1 jika ada build yang gagal atau
+# output yang berbeda.
+#
+# Input: operand kecil acak, kasus carry berat (99..9, 10^k) dan operand besar yang rencananya
+# memakai dua atau tiga prima. Mode referensi lambat; operand terbesar di sini butuh beberapa detik.
+
+cd "$(dirname "$0")" || exit 1
+
+SOURCE_FILE="ntt_calculator.c"
+SEED="${1:-12345}"
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "${WORK_DIR}"' EXIT
+
+build() {
+  local name=$1; shift
+  echo "Compiling ${name}..."
+  if ! gcc -O3 -Wall -Wextra -pthread "$@" "${SOURCE_FILE}" -o "${WORK_DIR}/${name}"; then
+    echo "Compilation of ${name} failed."
+    exit 1
+  fi
+}
+
+build reference
+build native -DNTT_NATIVE
+build native_barrett -DNTT_NATIVE -DNTT_BARRETT
+
+awk -v seed="${SEED}" '
+function digits(len, first,   s, i) {
+  s = first ? int(1 + rand() * 9) : int(rand() * 10)
+  for (i = 1; i < len; i++) s = s int(rand() * 10)
+  return s
+}
+function repeat(ch, len,   s, i) { s = ""; for (i = 0; i < len; i++) s = s ch; return s }
+BEGIN {
+  srand(seed)
+  # kecil acak
+  for (i = 0; i < 200; i++) print digits(1 + int(rand() * 40), 1), digits(1 + int(rand() * 40), 1)
+  print "0 0"; print "0 12345"; print "1 1"; print "9 9"
+  # carry berat
+  split("1 2 5 8 9 10 17 18 19 64 100 1000 5000", ks, " ")
+  for (i in ks) { k = ks[i]; print repeat("9", k), repeat("9", k); print "1" repeat("0", k), "1" repeat("0", k) }
+  print repeat("9", 20000), "9"
+  # multi-prima dan tidak seimbang
+  split("1000 5000 20000 30000", ns, " ")
+  for (i in ns) print digits(ns[i], 1), digits(ns[i], 1)
+  print digits(30000, 1), digits(7, 1)
+  print "exit"
+}' > "${WORK_DIR}/input.txt"
+
+echo "Running $(($(wc -l < "${WORK_DIR}/input.txt") - 1)) products..."
+for name in reference native native_barrett; do
+  "${WORK_DIR}/${name}" -t 2 < "${WORK_DIR}/input.txt" > "${WORK_DIR}/${name}.out"
+done
+
+STATUS=0
+for name in native native_barrett; do
+  if cmp -s "${WORK_DIR}/reference.out" "${WORK_DIR}/${name}.out"; then
+    echo "${name}: identik dengan referensi"
+  else
+    echo "${name}: BERBEDA dari referensi"
+    diff "${WORK_DIR}/reference.out" "${WORK_DIR}/${name}.out" | cut -c1-120 | head -n 20
+    STATUS=1
+  fi
+done
+exit $STATUS